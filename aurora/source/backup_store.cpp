@@ -0,0 +1,335 @@
+#include "backup_store.hpp"
+
+#include "binary_cursor.hpp"
+#include "binary_writer.hpp"
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <system_error>
+
+#ifdef __linux__
+#	include <fcntl.h>
+#	include <linux/fs.h>
+#	include <sys/ioctl.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace {
+	constexpr uint32_t kManifestMagic = 0x4e414d41; // "AMAN"
+	constexpr uint32_t kManifestVersion = 1;
+
+	// Chunks average around 64 KiB past the minimum, a single record edit rewrites one or two of them
+	constexpr size_t kMinChunk = 16 * 1024;
+	constexpr size_t kMaxChunk = 256 * 1024;
+	constexpr int kCutBits = 16;
+
+	// Random value per byte for the rolling gear hash
+	constexpr std::array<uint64_t, 256> kGear = [] {
+		std::array<uint64_t, 256> table{};
+		uint64_t state = 0x41555230524f5241; // Fixed seed, chunk boundaries must never change between runs
+
+		for (uint64_t& value : table) {
+			state += 0x9e3779b97f4a7c15ull;
+			uint64_t z = state;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			value = z ^ (z >> 31);
+		}
+
+		return table;
+	}();
+
+	// Length of the next chunk, cut where the gear hash of the last 64 bytes has its top bits clear
+	// Boundaries depend only on nearby content, so inserting or removing bytes moves just the chunks around the edit
+	size_t next_chunk(std::span<std::byte const> data) {
+		if (data.size() <= kMinChunk) return data.size();
+
+		size_t const end = std::min(data.size(), kMaxChunk);
+		uint64_t hash = 0;
+
+		for (size_t i = kMinChunk; i < end; ++i) {
+			hash = (hash << 1) + kGear[static_cast<uint8_t>(data[i])];
+			if ((hash >> (64 - kCutBits)) == 0) return i + 1;
+		}
+
+		return end;
+	}
+
+	std::string hex(aurora::Hash128 hash) {
+		char buffer[32];
+		for (int i = 0; i < 16; ++i) {
+			uint64_t word = i < 8 ? hash.high : hash.low;
+			unsigned byte = static_cast<unsigned>(word >> (56 - (i % 8) * 8)) & 0xff;
+			buffer[i * 2] = "0123456789abcdef"[byte >> 4];
+			buffer[i * 2 + 1] = "0123456789abcdef"[byte & 15];
+		}
+		return std::string(buffer, 32);
+	}
+
+	// Written next to the target then renamed, a crash never leaves a torn chunk or manifest behind
+	bool write_atomic(std::filesystem::path const& path, std::span<std::byte const> bytes) {
+		std::filesystem::path temporary = path;
+		temporary += ".tmp";
+
+		{
+			std::ofstream stream(temporary, std::ios::out | std::ios::binary);
+			if (!stream) return false;
+			stream.write(reinterpret_cast<char const*>(bytes.data()), bytes.size());
+			if (!stream) return false;
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(temporary, path, ec);
+		return !ec;
+	}
+
+#ifdef __linux__
+	// Shares the source blocks with the chunk file instead of copying them
+	// Only block aligned ranges on reflink capable filesystems (btrfs, xfs) can be cloned
+	bool clone_chunk(int sourceFd, size_t blockSize, size_t offset, size_t length, bool reachesEnd, std::filesystem::path const& path) {
+		if (sourceFd == -1 || offset % blockSize != 0 || (length % blockSize != 0 && !reachesEnd)) return false;
+
+		std::filesystem::path temporary = path;
+		temporary += ".tmp";
+
+		int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (fd == -1) return false;
+
+		file_clone_range range{};
+		range.src_fd = sourceFd;
+		range.src_offset = offset;
+		range.src_length = reachesEnd ? 0 : length; // Zero clones up to the end of the source
+		range.dest_offset = 0;
+
+		bool ok = ::ioctl(fd, FICLONERANGE, &range) == 0;
+		::close(fd);
+
+		std::error_code ec;
+		if (ok) std::filesystem::rename(temporary, path, ec);
+		if (!ok || ec) std::filesystem::remove(temporary, ec);
+		return ok && !ec;
+	}
+#endif
+}
+
+std::optional<uint32_t> aurora::BackupStore::snapshot(std::filesystem::path const& file) {
+	std::string name = file.filename().string();
+
+	std::filesystem::path legacy = file;
+	legacy += ".bak";
+
+	if (versions(file).empty() && std::filesystem::exists(legacy)) {
+		if (snapshot_as(legacy, name)) {
+			std::error_code ec;
+			std::filesystem::remove(legacy, ec);
+		}
+	}
+
+	return snapshot_as(file, name);
+}
+
+std::optional<uint32_t> aurora::BackupStore::snapshot_as(std::filesystem::path const& source, std::string const& name) {
+	auto mapping = MappedFile::open(source);
+	if (!mapping) return std::nullopt;
+
+	std::error_code ec;
+	std::filesystem::create_directories(manifest_directory(name), ec);
+	if (ec) return std::nullopt;
+
+#ifdef __linux__
+	int sourceFd = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+	size_t blockSize = 4096;
+	struct stat info;
+	if (sourceFd != -1 && fstat(sourceFd, &info) == 0 && info.st_blksize > 0) blockSize = static_cast<size_t>(info.st_blksize);
+#endif
+
+	Manifest manifest;
+	manifest.version.size = mapping->size();
+	manifest.version.time = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+	bool ok = true;
+	std::span<std::byte const> remaining = mapping->bytes();
+
+	while (ok && !remaining.empty()) {
+		size_t offset = mapping->size() - remaining.size();
+		std::span<std::byte const> chunk = remaining.first(next_chunk(remaining));
+		remaining = remaining.subspan(chunk.size());
+
+		Hash128 hash = murmur3_128(chunk);
+		manifest.chunks.push_back({ hash, static_cast<uint32_t>(chunk.size()) });
+
+		// Chunks already stored are shared, that's where the savings come from
+		std::filesystem::path path = chunk_path(hash);
+		if (std::filesystem::exists(path)) continue;
+
+		std::filesystem::create_directories(path.parent_path(), ec);
+
+#ifdef __linux__
+		if (clone_chunk(sourceFd, blockSize, offset, chunk.size(), remaining.empty(), path)) continue;
+#endif
+
+		ok = write_atomic(path, chunk);
+	}
+
+#ifdef __linux__
+	if (sourceFd != -1) ::close(sourceFd);
+#endif
+
+	if (!ok) return std::nullopt;
+
+	std::vector<Version> existing = versions(std::filesystem::path(name));
+	if (!existing.empty()) {
+		std::optional<Manifest> latest = read_manifest(name, existing.back().number);
+		bool unchanged = latest && latest->version.size == manifest.version.size && std::equal(latest->chunks.begin(), latest->chunks.end(), manifest.chunks.begin(), manifest.chunks.end(), [](Chunk const& a, Chunk const& b) {
+			return a.hash == b.hash && a.length == b.length;
+		});
+
+		if (unchanged) return existing.back().number;
+	}
+
+	manifest.version.number = existing.empty() ? 1 : existing.back().number + 1;
+
+	std::vector<std::byte> data(4 * sizeof(uint32_t) + sizeof(uint64_t) + sizeof(int64_t) + manifest.chunks.size() * (sizeof(Hash128) + sizeof(uint32_t)));
+	BinaryWriter writer(data);
+	writer.write_u32(kManifestMagic);
+	writer.write_u32(kManifestVersion);
+	writer.write_u32(manifest.version.number);
+	writer.write(manifest.version.size);
+	writer.write(manifest.version.time);
+	writer.write_u32(static_cast<uint32_t>(manifest.chunks.size()));
+
+	for (Chunk const& chunk : manifest.chunks) {
+		writer.write(chunk.hash);
+		writer.write_u32(chunk.length);
+	}
+
+	if (!write_atomic(manifest_directory(name) / std::to_string(manifest.version.number), data)) return std::nullopt;
+	return manifest.version.number;
+}
+
+std::optional<aurora::BackupStore::Manifest> aurora::BackupStore::read_manifest(std::string const& name, uint32_t number) const {
+	auto file = MappedFile::open(manifest_directory(name) / std::to_string(number));
+	if (!file) return std::nullopt;
+
+	try {
+		BinaryCursor cursor(file->bytes());
+		if (cursor.read_u32() != kManifestMagic) return std::nullopt;
+		if (cursor.read_u32() != kManifestVersion) return std::nullopt;
+
+		Manifest manifest;
+		manifest.version.number = cursor.read_u32();
+		manifest.version.size = cursor.read<uint64_t>();
+		manifest.version.time = cursor.read<int64_t>();
+
+		uint32_t count = cursor.read_u32();
+		manifest.chunks.reserve(std::min<size_t>(count, cursor.remaining() / (sizeof(Hash128) + sizeof(uint32_t))));
+
+		for (uint32_t i = 0; i < count; ++i) {
+			auto record = cursor.record(sizeof(Hash128) + sizeof(uint32_t));
+			Chunk chunk;
+			chunk.hash = record.read<Hash128>();
+			chunk.length = record.u32();
+			manifest.chunks.push_back(chunk);
+		}
+
+		return manifest;
+	}
+	catch (TruncatedData const&) {
+		return std::nullopt;
+	}
+}
+
+std::vector<aurora::BackupStore::Version> aurora::BackupStore::versions(std::filesystem::path const& file) const {
+	std::string name = file.filename().string();
+	std::vector<Version> versions;
+
+	std::error_code ec;
+	for (auto const& entry : std::filesystem::directory_iterator(manifest_directory(name), ec)) {
+		std::string stem = entry.path().filename().string();
+
+		uint32_t number = 0;
+		auto [end, error] = std::from_chars(stem.data(), stem.data() + stem.size(), number);
+		if (error != std::errc() || end != stem.data() + stem.size()) continue; // Temporary files
+
+		if (std::optional<Manifest> manifest = read_manifest(name, number))
+			versions.push_back(manifest->version);
+	}
+
+	std::sort(versions.begin(), versions.end(), [](Version const& a, Version const& b) { return a.number < b.number; });
+	return versions;
+}
+
+std::vector<std::string> aurora::BackupStore::files() const {
+	std::vector<std::string> files;
+
+	std::error_code ec;
+	for (auto const& entry : std::filesystem::directory_iterator(mRoot / "manifests", ec))
+		if (entry.is_directory(ec))
+			files.push_back(entry.path().filename().string());
+
+	std::sort(files.begin(), files.end());
+	return files;
+}
+
+bool aurora::BackupStore::restore(std::filesystem::path const& file, uint32_t version) {
+	std::optional<Manifest> manifest = read_manifest(file.filename().string(), version);
+	if (!manifest) return false;
+
+	// Only touch the file once every chunk is known to be there
+	for (Chunk const& chunk : manifest->chunks) {
+		std::error_code ec;
+		if (std::filesystem::file_size(chunk_path(chunk.hash), ec) != chunk.length || ec) return false;
+	}
+
+	if (std::filesystem::exists(file) && !snapshot(file)) return false;
+
+	std::filesystem::path temporary = file;
+	temporary += ".tmp";
+
+	bool ok = true;
+
+	{
+		std::ofstream stream(temporary, std::ios::out | std::ios::binary);
+		ok = static_cast<bool>(stream);
+
+		// Streams one chunk at a time, a chunk is at most kMaxChunk bytes
+		std::vector<char> buffer;
+		buffer.reserve(kMaxChunk);
+
+		for (Chunk const& chunk : manifest->chunks) {
+			if (!ok) break;
+
+			buffer.resize(chunk.length);
+			std::ifstream input(chunk_path(chunk.hash), std::ios::in | std::ios::binary);
+			input.read(buffer.data(), buffer.size());
+
+			// A damaged chunk must never end up in the restored file
+			ok = input && murmur3_128(std::as_bytes(std::span(buffer))) == chunk.hash;
+			if (ok) ok = static_cast<bool>(stream.write(buffer.data(), buffer.size()));
+		}
+	}
+
+	std::error_code ec;
+	if (ok) std::filesystem::rename(temporary, file, ec);
+
+	if (!ok || ec) {
+		std::filesystem::remove(temporary, ec);
+		return false;
+	}
+
+	return true;
+}
+
+std::filesystem::path aurora::BackupStore::chunk_path(Hash128 hash) const {
+	std::string name = hex(hash);
+	return mRoot / "chunks" / name.substr(0, 2) / name;
+}
+
+std::filesystem::path aurora::BackupStore::manifest_directory(std::string const& name) const {
+	return mRoot / "manifests" / name;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "murmur3.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace aurora {
+	// Every earlier version of the files we modify, kept under one directory
+	// Files are cut into content defined chunks stored once by their hash, a version is a manifest listing its chunks
+	// An edit only changes the chunks around it, every other chunk is shared with the earlier versions and other files
+	//
+	// root/chunks/ab/ab...    chunk contents, named by their hash
+	// root/manifests/name/N   chunk list of version N of the file `name`
+	class BackupStore final {
+	public:
+		struct Version {
+			uint32_t number;
+			int64_t time; // Seconds since the unix epoch
+			uint64_t size;
+		};
+
+		explicit BackupStore(std::filesystem::path root) : mRoot(std::move(root)) {}
+
+		// Records the current contents of `file` as a new version, returns its number
+		// A file identical to its latest version returns that version instead of adding another
+		// A legacy `file.bak` copy is imported as the first version and removed
+		std::optional<uint32_t> snapshot(std::filesystem::path const& file);
+
+		// Oldest first
+		std::vector<Version> versions(std::filesystem::path const& file) const;
+
+		// File names with at least one version
+		std::vector<std::string> files() const;
+
+		// Reassembles a version over `file`, the current contents are snapshot first so restoring can be undone too
+		bool restore(std::filesystem::path const& file, uint32_t version);
+	private:
+		struct Chunk {
+			Hash128 hash;
+			uint32_t length;
+		};
+
+		struct Manifest {
+			Version version;
+			std::vector<Chunk> chunks;
+		};
+
+		std::optional<uint32_t> snapshot_as(std::filesystem::path const& source, std::string const& name);
+		std::optional<Manifest> read_manifest(std::string const& name, uint32_t number) const;
+
+		std::filesystem::path chunk_path(Hash128 hash) const;
+		std::filesystem::path manifest_directory(std::string const& name) const;
+
+		std::filesystem::path mRoot;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,415 @@
+#include "benchmarks.hpp"
+
+#include "binary_cursor.hpp"
+#include "leaf.hpp"
+#include "parallel.hpp"
+#include "thumper_structs.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <map>
+#include <vector>
+
+namespace {
+	// The readers every parser used before BinaryCursor, unchecked and kept here as the baseline
+	namespace legacy {
+		uint32_t readUint32(char const** ptr) {
+			uint32_t value;
+			memcpy(&value, *ptr, sizeof(uint32_t));
+			*ptr += sizeof(uint32_t);
+			return value;
+		}
+
+		std::string readString(char const** ptr) {
+			uint32_t length = readUint32(ptr);
+			std::string string;
+			string.resize(length);
+			memcpy(string.data(), *ptr, length);
+			*ptr += length;
+			return string;
+		}
+
+		std::string_view readStringView(char const** ptr) {
+			uint32_t length = readUint32(ptr);
+			std::string_view string(*ptr, length);
+			*ptr += length;
+			return string;
+		}
+
+		// MeshFile::serialize before the exact size writer, the stream grew with every field
+		std::vector<std::byte> serializeMesh(thumper::MeshFile const& file) {
+			std::vector<std::byte> data;
+			auto append = [&](std::span<std::byte const> bytes) { data.insert(data.end(), bytes.begin(), bytes.end()); };
+			auto append_u32 = [&](uint32_t value) { append(std::as_bytes(std::span(&value, 1))); };
+			auto append_u16 = [&](uint16_t value) { append(std::as_bytes(std::span(&value, 1))); };
+
+			append_u32(6);
+			append_u32(static_cast<uint32_t>(file.meshes.size()));
+
+			for (auto const& mesh : file.meshes) {
+				append_u32(mesh.vertexCount);
+				append(std::as_bytes(file.vertices_of(mesh)));
+				append_u32(mesh.triangleCount);
+				append(std::as_bytes(file.triangles_of(mesh)));
+				append_u16(mesh._unknownField4);
+			}
+
+			return data;
+		}
+	}
+
+	size_t skip_objlib_header(Objlib const& lib) {
+		size_t offset = sizeof(ObjlibHeader);
+		if (lib.header.objType == ObjType::kObjlibLevel || lib.header.objType == ObjType::kObjlibAvatar || lib.header.objType == ObjType::kObjlibSequin)
+			offset += sizeof(uint32_t);
+		return offset;
+	}
+
+	uint64_t checksum(std::string_view string) {
+		return string.empty() ? 0 : string.size() + static_cast<unsigned char>(string.front());
+	}
+
+	// `Read` gets the lib and returns a checksum over every field so nothing is optimized away
+	template <class Read>
+	double time_ms(std::span<Objlib const* const> libs, int iterations, uint64_t& sink, Read&& read) {
+		auto begin = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < iterations; ++i)
+			for (Objlib const* lib : libs)
+				sink += read(*lib);
+
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count() / iterations;
+	}
+
+	template <class ReadString>
+	uint64_t walk_legacy(Objlib const& lib, ReadString&& readString) {
+		char const* ptr = lib.raw.data() + skip_objlib_header(lib);
+		uint64_t sum = 0;
+
+		uint32_t libraryImportCount = legacy::readUint32(&ptr);
+		for (uint32_t i = 0; i < libraryImportCount; ++i) {
+			sum += legacy::readUint32(&ptr);
+			sum += checksum(readString(&ptr));
+		}
+
+		sum += checksum(readString(&ptr));
+
+		uint32_t objectImportCount = legacy::readUint32(&ptr);
+		for (uint32_t i = 0; i < objectImportCount; ++i) {
+			sum += legacy::readUint32(&ptr);
+			sum += checksum(readString(&ptr));
+			sum += legacy::readUint32(&ptr);
+			sum += checksum(readString(&ptr));
+		}
+
+		uint32_t objectCount = legacy::readUint32(&ptr);
+		for (uint32_t i = 0; i < objectCount; ++i) {
+			sum += legacy::readUint32(&ptr);
+			sum += checksum(readString(&ptr));
+		}
+
+		return sum;
+	}
+
+	uint64_t walk_cursor(Objlib const& lib) {
+		aurora::BinaryCursor cursor(lib.raw.bytes(), skip_objlib_header(lib));
+		uint64_t sum = 0;
+
+		uint32_t libraryImportCount = cursor.read_u32();
+		for (uint32_t i = 0; i < libraryImportCount; ++i) {
+			sum += cursor.read_u32();
+			sum += checksum(cursor.read_string_view());
+		}
+
+		sum += checksum(cursor.read_string_view());
+
+		uint32_t objectImportCount = cursor.read_u32();
+		for (uint32_t i = 0; i < objectImportCount; ++i) {
+			sum += cursor.read_u32();
+			sum += checksum(cursor.read_string_view());
+			sum += cursor.read_u32();
+			sum += checksum(cursor.read_string_view());
+		}
+
+		uint32_t objectCount = cursor.read_u32();
+		for (uint32_t i = 0; i < objectCount; ++i) {
+			sum += cursor.read_u32();
+			sum += checksum(cursor.read_string_view());
+		}
+
+		return sum;
+	}
+
+	// Same walk with the type and length prefix of each entry validated together
+	uint64_t walk_cursor_records(Objlib const& lib) {
+		aurora::BinaryCursor cursor(lib.raw.bytes(), skip_objlib_header(lib));
+		uint64_t sum = 0;
+
+		auto read_body = [&](uint32_t length) {
+			std::span<std::byte const> bytes = cursor.read_bytes(length);
+			return std::string_view(reinterpret_cast<char const*>(bytes.data()), bytes.size());
+		};
+
+		uint32_t libraryImportCount = cursor.read_u32();
+		for (uint32_t i = 0; i < libraryImportCount; ++i) {
+			auto record = cursor.record(2 * sizeof(uint32_t));
+			sum += record.u32();
+			sum += checksum(read_body(record.u32()));
+		}
+
+		sum += checksum(cursor.read_string_view());
+
+		uint32_t objectImportCount = cursor.read_u32();
+		for (uint32_t i = 0; i < objectImportCount; ++i) {
+			auto head = cursor.record(2 * sizeof(uint32_t));
+			sum += head.u32();
+			sum += checksum(read_body(head.u32()));
+			auto tail = cursor.record(2 * sizeof(uint32_t));
+			sum += tail.u32();
+			sum += checksum(read_body(tail.u32()));
+		}
+
+		uint32_t objectCount = cursor.read_u32();
+		for (uint32_t i = 0; i < objectCount; ++i) {
+			auto record = cursor.record(2 * sizeof(uint32_t));
+			sum += record.u32();
+			sum += checksum(read_body(record.u32()));
+		}
+
+		return sum;
+	}
+}
+
+std::string aurora::benchmark_readers(std::span<Objlib const* const> libs, int iterations) {
+	size_t bytes = 0;
+	for (Objlib const* lib : libs)
+		bytes += lib->headerDefOffset;
+
+	// Touch every header once so the first variant doesn't pay for the page faults
+	uint64_t sink = 0;
+	time_ms(libs, 1, sink, [](Objlib const& lib) { return walk_cursor(lib); });
+
+	struct Result {
+		char const* name;
+		double ms;
+	};
+
+	Result results[] = {
+		{ "pointer readers, std::string", time_ms(libs, iterations, sink, [](Objlib const& lib) { return walk_legacy(lib, legacy::readString); }) },
+		{ "pointer readers, views (unchecked)", time_ms(libs, iterations, sink, [](Objlib const& lib) { return walk_legacy(lib, legacy::readStringView); }) },
+		{ "BinaryCursor, checked per field", time_ms(libs, iterations, sink, [](Objlib const& lib) { return walk_cursor(lib); }) },
+		{ "BinaryCursor, checked per record", time_ms(libs, iterations, sink, [](Objlib const& lib) { return walk_cursor_records(lib); }) },
+	};
+
+	std::string report = std::format("Header tables of {} objlibs, {:.2f} MiB, {} iterations\n", libs.size(), bytes / (1024.0 * 1024.0), iterations);
+
+	for (Result const& result : results) {
+		double throughput = result.ms > 0.0 ? (bytes / (1024.0 * 1024.0)) / (result.ms / 1000.0) : 0.0;
+		report += std::format("{:<36} {:>9.3f} ms {:>10.1f} MiB/s\n", result.name, result.ms, throughput);
+	}
+
+	report += std::format("checksum {:016X}\n", sink);
+	return report;
+}
+
+std::string aurora::benchmark_mesh_writers(std::span<std::filesystem::path const> paths, int iterations) {
+	std::vector<thumper::MeshFile> files;
+	files.reserve(paths.size());
+
+	size_t bytes = 0;
+	for (auto const& path : paths) {
+		if (auto file = thumper::MeshFile::from_file(path)) {
+			bytes += file->serialized_size();
+			files.push_back(std::move(file.value()));
+		}
+	}
+
+	std::filesystem::path const target = std::filesystem::temp_directory_path() / "aurora_benchmark.pc";
+
+	struct Result {
+		char const* name;
+		double ms;
+	};
+
+	auto time_ms = [&](auto&& write) {
+		auto begin = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < iterations; ++i)
+			for (thumper::MeshFile const& file : files)
+				write(file);
+
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count() / iterations;
+	};
+
+	size_t sink = 0;
+	bool failed = false;
+
+	Result results[] = {
+		{ "growing stream, in memory", time_ms([&](thumper::MeshFile const& file) { sink += legacy::serializeMesh(file).size(); }) },
+		{ "exact size writer, in memory", time_ms([&](thumper::MeshFile const& file) { sink += file.serialize().size(); }) },
+		{ "growing stream + ofstream, to disk", time_ms([&](thumper::MeshFile const& file) {
+			std::vector<std::byte> data = legacy::serializeMesh(file);
+			std::ofstream stream(target, std::ios::out | std::ios::binary);
+			stream.write(reinterpret_cast<char const*>(data.data()), data.size());
+			failed |= !stream;
+		}) },
+		{ "gathered write, to disk", time_ms([&](thumper::MeshFile const& file) { failed |= !file.to_file(target); }) },
+	};
+
+	std::error_code ec;
+	std::filesystem::remove(target, ec);
+
+	std::string report = std::format("Serialized {} meshes, {:.2f} MiB, {} iterations\n", files.size(), bytes / (1024.0 * 1024.0), iterations);
+
+	for (Result const& result : results) {
+		double throughput = result.ms > 0.0 ? (bytes / (1024.0 * 1024.0)) / (result.ms / 1000.0) : 0.0;
+		report += std::format("{:<36} {:>9.3f} ms {:>10.1f} MiB/s\n", result.name, result.ms, throughput);
+	}
+
+	if (failed) report += std::format("Writing to {} failed\n", target.string());
+	report += std::format("checksum {}\n", sink);
+	return report;
+}
+
+std::string aurora::benchmark_leaf_decoding(std::span<Objlib const* const> libs, int iterations) {
+	struct Record {
+		Objlib const* lib;
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	std::vector<Record> records;
+	size_t bytes = 0;
+	for (Objlib const* lib : libs) {
+		for (Object const& object : lib->objects) {
+			if (object.type != ObjType::kLeaf || object.offset == 0) continue;
+
+			// Object::length is often unknown, the decoder tells where the record ends
+			Leaf leaf;
+			BinaryCursor cursor(lib->raw.bytes(), object.offset);
+			try {
+				leaf.deserialize(cursor);
+			}
+			catch (TruncatedData const&) {}
+			catch (UnknownTraitType const&) {}
+
+			uint32_t const length = static_cast<uint32_t>(cursor.offset() - object.offset);
+			records.push_back({ lib, object.offset, length });
+			bytes += length;
+		}
+	}
+
+	// Traits decoded, the checksum that keeps the work from being optimized away
+	auto decode = [](Record const& record) -> uint64_t {
+		Leaf leaf;
+		BinaryCursor cursor(record.lib->raw.bytes(), record.offset);
+
+		try {
+			leaf.deserialize(cursor);
+		}
+		catch (TruncatedData const&) {}
+		catch (UnknownTraitType const&) {}
+
+		uint64_t sum = leaf.traits.size();
+		for (Leaf::Trait const& trait : leaf.traits)
+			sum += trait.datapoint_count();
+		return sum;
+	};
+
+	auto time_ms = [&](auto&& run) {
+		auto begin = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < iterations; ++i)
+			run();
+
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count() / iterations;
+	};
+
+	std::atomic<uint64_t> sink = 0;
+
+	// Floor for any decoder, every byte of every leaf loaded once
+	auto scan = [&] {
+		uint64_t sum = 0;
+		for (Record const& record : records) {
+			char const* data = record.lib->raw.data() + record.offset;
+			for (size_t i = 0; i + sizeof(uint64_t) <= record.length; i += sizeof(uint64_t)) {
+				uint64_t word;
+				memcpy(&word, data + i, sizeof(word));
+				sum += word;
+			}
+		}
+		sink += sum;
+	};
+
+	scan(); // Page faults are paid here, not by the first variant
+
+	struct Result {
+		char const* name;
+		double ms;
+	};
+
+	Result results[] = {
+		{ "scan, one thread", time_ms(scan) },
+		{ "decode, one thread", time_ms([&] {
+			uint64_t sum = 0;
+			for (Record const& record : records)
+				sum += decode(record);
+			sink += sum;
+		}) },
+		{ "decode, all threads", time_ms([&] {
+			parallel_for(records.size(), [&](size_t index, unsigned) { sink += decode(records[index]); });
+		}) },
+	};
+
+	// Correctness pass, not timed
+	size_t complete = 0;
+	size_t truncated = 0;
+	size_t mismatched = 0;
+	size_t traits = 0;
+	size_t datapoints = 0;
+	std::map<uint32_t, size_t> unknownTypes;
+
+	for (Record const& record : records) {
+		Leaf leaf;
+		BinaryCursor cursor(record.lib->raw.bytes(), record.offset);
+
+		try {
+			leaf.deserialize(cursor);
+			++complete;
+
+			std::vector<uint8_t> encoded = leaf.serialize();
+			size_t consumed = cursor.offset() - record.offset;
+			if (encoded.size() != consumed || memcmp(encoded.data(), record.lib->raw.data() + record.offset, consumed) != 0) ++mismatched;
+		}
+		catch (TruncatedData const&) {
+			++truncated;
+		}
+		catch (UnknownTraitType const& e) {
+			++unknownTypes[static_cast<uint32_t>(e.type())];
+		}
+
+		traits += leaf.traits.size();
+		for (Leaf::Trait const& trait : leaf.traits)
+			datapoints += trait.datapoint_count();
+	}
+
+	std::string report = std::format("Decoded {} leafs, {:.2f} MiB, {} traits, {} datapoints, {} iterations, {} threads\n", records.size(), bytes / (1024.0 * 1024.0), traits, datapoints, iterations, worker_count());
+
+	for (Result const& result : results) {
+		double throughput = result.ms > 0.0 ? (bytes / (1024.0 * 1024.0)) / (result.ms / 1000.0) : 0.0;
+		report += std::format("{:<36} {:>9.3f} ms {:>10.1f} MiB/s\n", result.name, result.ms, throughput);
+	}
+
+	report += std::format("{} complete, {} truncated, {} re-encoded differently\n", complete, truncated, mismatched);
+	for (auto const& [type, count] : unknownTypes)
+		report += std::format("{} stopped at a {} trait ({})\n", count, trait_codec(static_cast<TraitType>(type)).name, type);
+
+	report += std::format("checksum {:016X}\n", sink.load());
+	return report;
+}
\ No newline at end of file
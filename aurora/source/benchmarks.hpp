@@ -0,0 +1,21 @@
+#pragma once
+
+#include "objlib.hpp"
+
+#include <filesystem>
+#include <span>
+#include <string>
+
+namespace aurora {
+	// Walks the header tables of every objlib with the original pointer readers and with BinaryCursor
+	// Returns a human readable timing report
+	std::string benchmark_readers(std::span<Objlib const* const> libs, int iterations = 20);
+
+	// Loads every mesh in `paths` then serializes all of them, growing a stream as before and with the exact size writer
+	// Also writes each one to a temporary file through a staged ofstream and through a gathered write
+	std::string benchmark_mesh_writers(std::span<std::filesystem::path const> paths, int iterations = 3);
+
+	// Decodes every located Leaf on one thread and on all of them, next to a plain scan of the same bytes
+	// Also encodes each one again to check the round trip, and counts which trait types stop decoding
+	std::string benchmark_leaf_decoding(std::span<Objlib const* const> libs, int iterations = 5);
+}
\ No newline at end of file
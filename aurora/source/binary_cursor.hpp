@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace aurora {
+	// Thrown when a parser would read past the end of its buffer
+	// Parsers catch this and report the file or record as malformed
+	class TruncatedData final : public std::runtime_error {
+	public:
+		using std::runtime_error::runtime_error;
+	};
+
+	// Little endian reader over an immutable byte range, shared by every parser
+	// Fixed size runs of fields are validated with a single check through `record`, the fields inside are then
+	// decoded with plain memcpy loads. Those are alignment safe and compile down to single unaligned moves
+	class BinaryCursor final {
+	public:
+		// Fields of a range already validated by `BinaryCursor::record`, reads are unchecked
+		class Record final {
+		public:
+			template <class T>
+			T read() {
+				static_assert(std::is_trivially_copyable_v<T>);
+				assert(mPtr + sizeof(T) <= mEnd);
+				T value;
+				memcpy(&value, mPtr, sizeof(T));
+				mPtr += sizeof(T);
+				return value;
+			}
+
+			uint8_t u8() { return read<uint8_t>(); }
+			uint16_t u16() { return read<uint16_t>(); }
+			uint32_t u32() { return read<uint32_t>(); }
+			float f32() { return read<float>(); }
+
+			void bytes(void* destination, size_t count) {
+				assert(mPtr + count <= mEnd);
+				memcpy(destination, mPtr, count);
+				mPtr += count;
+			}
+		private:
+			friend class BinaryCursor;
+			Record(char const* ptr, [[maybe_unused]] char const* end) : mPtr(ptr) {
+#ifndef NDEBUG
+				mEnd = end;
+#endif
+			}
+
+			char const* mPtr;
+#ifndef NDEBUG
+			char const* mEnd;
+#endif
+		};
+
+		BinaryCursor() = default;
+		BinaryCursor(char const* begin, char const* end, size_t offset = 0) : mBegin(begin), mPtr(begin), mEnd(end) { seek(offset); }
+		BinaryCursor(std::span<std::byte const> data, size_t offset = 0)
+			: BinaryCursor(reinterpret_cast<char const*>(data.data()), reinterpret_cast<char const*>(data.data() + data.size()), offset) {
+		}
+
+		Record record(size_t size) {
+			require(size);
+			Record record(mPtr, mPtr + size);
+			mPtr += size;
+			return record;
+		}
+
+		template <class T>
+		T read() { return record(sizeof(T)).template read<T>(); }
+
+		uint8_t read_u8() { return read<uint8_t>(); }
+		uint16_t read_u16() { return read<uint16_t>(); }
+		uint32_t read_u32() { return read<uint32_t>(); }
+		float read_f32() { return read<float>(); }
+
+		std::span<std::byte const> read_bytes(size_t count) {
+			require(count);
+			std::span<std::byte const> bytes(reinterpret_cast<std::byte const*>(mPtr), count);
+			mPtr += count;
+			return bytes;
+		}
+
+		// Length prefixed string, the view points into the underlying buffer
+		std::string_view read_string_view() {
+			uint32_t length = read_u32();
+			require(length);
+			std::string_view string(mPtr, length);
+			mPtr += length;
+			return string;
+		}
+
+		std::string read_string() { return std::string(read_string_view()); }
+
+		void skip(size_t count) {
+			require(count);
+			mPtr += count;
+		}
+
+		void seek(size_t offset) {
+			if (offset > size()) throw TruncatedData("Seek past end of data");
+			mPtr = mBegin + offset;
+		}
+
+		char const* begin() const { return mBegin; }
+		char const* ptr() const { return mPtr; }
+		size_t offset() const { return static_cast<size_t>(mPtr - mBegin); }
+		size_t size() const { return static_cast<size_t>(mEnd - mBegin); }
+		size_t remaining() const { return static_cast<size_t>(mEnd - mPtr); }
+	private:
+		void require(size_t count) const {
+			if (remaining() < count) throw TruncatedData("Read past end of data");
+		}
+
+		char const* mBegin = nullptr;
+		char const* mPtr = nullptr;
+		char const* mEnd = nullptr;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace aurora {
+	// Little endian writer into a buffer that was sized up front, the counterpart of BinaryCursor
+	// Callers compute the exact output size first, so fields are emitted with plain memcpy stores and never grow anything
+	class BinaryWriter final {
+	public:
+		BinaryWriter(std::span<std::byte> data) : mBegin(data.data()), mPtr(data.data()), mEnd(data.data() + data.size()) {}
+
+		// Size of a length prefixed string as written by `write_string`
+		static constexpr size_t string_size(std::string_view string) {
+			return sizeof(uint32_t) + string.size();
+		}
+
+		template <class T>
+		void write(T const& value) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			write_bytes(&value, sizeof(T));
+		}
+
+		void write_u8(uint8_t value) { write(value); }
+		void write_u16(uint16_t value) { write(value); }
+		void write_u32(uint32_t value) { write(value); }
+		void write_f32(float value) { write(value); }
+
+		void write_bytes(void const* source, size_t count) {
+			assert(count <= remaining());
+			memcpy(mPtr, source, count);
+			mPtr += count;
+		}
+
+		void write_bytes(std::span<std::byte const> bytes) {
+			write_bytes(bytes.data(), bytes.size());
+		}
+
+		void write_string(std::string_view string) {
+			write_u32(static_cast<uint32_t>(string.size()));
+			write_bytes(string.data(), string.size());
+		}
+
+		size_t offset() const { return static_cast<size_t>(mPtr - mBegin); }
+		size_t remaining() const { return static_cast<size_t>(mEnd - mPtr); }
+	private:
+		std::byte* mBegin;
+		std::byte* mPtr;
+		std::byte* mEnd;
+	};
+}
\ No newline at end of file
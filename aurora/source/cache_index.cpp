@@ -0,0 +1,62 @@
+#include "cache_index.hpp"
+
+#include "parallel.hpp"
+#include "thumper_structs.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+
+bool aurora::CacheEntry::is_mesh() const {
+	return probed && header.fileType == FileType::kMeshX && thumper::MeshFile::plausible_mesh_count(mesh_count());
+}
+
+aurora::CacheIndex aurora::CacheIndex::build(std::filesystem::path const& directory, Catalog const& catalog) {
+	CacheIndex index;
+
+	for (auto const& entry : std::filesystem::directory_iterator(directory)) {
+		if (entry.path().extension() != ".pc") continue;
+
+		std::error_code ec;
+		CacheEntry file;
+		file.path = entry.path();
+		file.name = entry.path().filename().string();
+		file.size = entry.file_size(ec);
+		if (ec) continue;
+		file.mtime = static_cast<int64_t>(entry.last_write_time(ec).time_since_epoch().count());
+		if (ec) continue;
+
+		index.entries.push_back(std::move(file));
+	}
+
+	std::sort(index.entries.begin(), index.entries.end(), [](CacheEntry const& a, CacheEntry const& b) { return a.path < b.path; });
+
+	parallel_for(index.entries.size(), [&](size_t i, unsigned) {
+		CacheEntry& file = index.entries[i];
+
+		if (auto header = catalog.lookup_header(file.name, file.size, file.mtime)) {
+			file.header = header.value();
+			file.probed = true;
+			file.cached = true;
+		}
+		else if (auto header = probe_header(file.path)) {
+			file.header = header.value();
+			file.probed = true;
+		}
+	});
+
+	return index;
+}
+
+size_t aurora::CacheIndex::count(FileType type) const {
+	return std::count_if(entries.begin(), entries.end(), [type](CacheEntry const& entry) { return entry.probed && entry.header.fileType == type; });
+}
+
+std::optional<ObjlibHeader> aurora::probe_header(std::filesystem::path const& path) {
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+	if (!file) return std::nullopt;
+
+	ObjlibHeader header{};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	return header;
+}
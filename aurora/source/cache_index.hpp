@@ -0,0 +1,43 @@
+#pragma once
+
+#include "catalog.hpp"
+#include "objlib.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace aurora {
+	struct CacheEntry final {
+		std::filesystem::path path;
+		std::string name; // File name, also the catalog key
+		uint64_t size = 0;
+		int64_t mtime = 0;
+
+		// Only the leading words, enough to tell the file type, mesh count and objlib type apart
+		ObjlibHeader header{};
+		bool probed = false; // Header is known
+		bool cached = false; // Header came from the catalog, the file wasn't opened
+
+		bool is_objlib() const { return probed && checkObjlibHeader(header) == ObjlibSupport::kSupported; }
+		bool is_mesh() const;
+
+		// Meshes store their LOD count where objlibs store their type
+		uint32_t mesh_count() const { return static_cast<uint32_t>(header.objType); }
+	};
+
+	// Every .pc file of the cache with its type, sorted by path
+	struct CacheIndex final {
+		std::vector<CacheEntry> entries;
+
+		// Header words come from the catalog where it's still valid, other files have their first bytes read
+		static CacheIndex build(std::filesystem::path const& directory, Catalog const& catalog);
+
+		size_t count(FileType type) const;
+	};
+
+	// Reads only the leading header words, short files are zero filled
+	std::optional<ObjlibHeader> probe_header(std::filesystem::path const& path);
+}
@@ -0,0 +1,220 @@
+#include "catalog.hpp"
+
+#include "binary_cursor.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+	constexpr uint32_t kMagic = 0x54414341; // "ACAT"
+	constexpr uint32_t kVersion = 4;
+
+	// Names are stored as an offset and length into the objlib itself, `raw` must be that same file
+	std::string_view read_name(aurora::BinaryCursor& cursor, aurora::MappedFile const& raw) {
+		auto record = cursor.record(2 * sizeof(uint32_t));
+		uint32_t offset = record.u32();
+		uint32_t length = record.u32();
+		if (offset > raw.size() || raw.size() - offset < length) throw aurora::TruncatedData("Catalog name outside of objlib");
+		return { raw.data() + offset, length };
+	}
+
+	struct Writer final {
+		std::vector<char>& buffer;
+
+		template <class T>
+		void write(T const& value) {
+			char const* bytes = reinterpret_cast<char const*>(&value);
+			buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+		}
+
+		void write_string(std::string_view value) {
+			write(static_cast<uint32_t>(value.size()));
+			buffer.insert(buffer.end(), value.begin(), value.end());
+		}
+
+		void write_name(std::string_view name, Objlib const& lib) {
+			write(static_cast<uint32_t>(name.data() - lib.raw.data()));
+			write(static_cast<uint32_t>(name.size()));
+		}
+	};
+}
+
+aurora::Catalog aurora::Catalog::load(std::filesystem::path const& path, std::string_view cacheDir) {
+	Catalog catalog;
+
+	auto file = MappedFile::open(path);
+	if (!file) return catalog;
+
+	try {
+		aurora::BinaryCursor cursor(file->bytes());
+		if (cursor.read_u32() != kMagic) return catalog;
+		if (cursor.read_u32() != kVersion) return catalog;
+		if (cursor.read_string_view() != cacheDir) return catalog;
+
+		uint32_t count = cursor.read_u32();
+
+		for (uint32_t i = 0; i < count; ++i) {
+			std::string_view name = cursor.read_string_view();
+
+			auto record = cursor.record(sizeof(uint64_t) + sizeof(int64_t) + sizeof(uint32_t));
+			Entry entry;
+			entry.size = record.read<uint64_t>();
+			entry.mtime = record.read<int64_t>();
+			entry.length = record.u32();
+			entry.offset = cursor.offset();
+
+			cursor.skip(entry.length);
+			catalog.mEntries[name] = entry;
+		}
+	}
+	catch (aurora::TruncatedData const&) {
+		catalog.mEntries.clear();
+		return catalog;
+	}
+
+	catalog.mFile = std::move(file.value());
+	return catalog;
+}
+
+bool aurora::Catalog::save(std::filesystem::path const& path, std::string_view cacheDir, std::span<Record const> records) {
+	std::vector<char> buffer;
+	Writer writer{ buffer };
+
+	writer.write(kMagic);
+	writer.write(kVersion);
+	writer.write_string(cacheDir);
+	writer.write(static_cast<uint32_t>(records.size()));
+
+	std::vector<char> payload;
+	Writer payloadWriter{ payload };
+
+	for (Record const& record : records) {
+		payload.clear();
+		payloadWriter.write(record.header);
+
+		if (Objlib const* lib = record.lib) {
+			payloadWriter.write(static_cast<uint64_t>(lib->headerDefOffset));
+			payloadWriter.write_name(lib->originalName, *lib);
+
+			payloadWriter.write(static_cast<uint32_t>(lib->libraryImports.size()));
+			for (auto const& import : lib->libraryImports) {
+				payloadWriter.write(import.unknown0);
+				payloadWriter.write_name(import.string, *lib);
+			}
+
+			payloadWriter.write(static_cast<uint32_t>(lib->objectImports.size()));
+			for (auto const& import : lib->objectImports) {
+				payloadWriter.write(import.type);
+				payloadWriter.write_name(import.objName, *lib);
+				payloadWriter.write(import.unknown0);
+				payloadWriter.write_name(import.libraryName, *lib);
+			}
+
+			payloadWriter.write(static_cast<uint32_t>(lib->objects.size()));
+			for (auto const& object : lib->objects) {
+				payloadWriter.write(object.type);
+				payloadWriter.write_name(object.name, *lib);
+				payloadWriter.write(object.offset);
+				payloadWriter.write(object.length);
+			}
+		}
+
+		writer.write_string(record.name);
+		writer.write(record.size);
+		writer.write(record.mtime);
+		writer.write(static_cast<uint32_t>(payload.size()));
+		buffer.insert(buffer.end(), payload.begin(), payload.end());
+	}
+
+	// Written next to the real file then swapped in, a crash mid write never leaves a torn catalog behind
+	std::filesystem::path temporary = path;
+	temporary += ".tmp";
+
+	{
+		std::ofstream stream(temporary, std::ios::out | std::ios::binary);
+		if (!stream) return false;
+		stream.write(buffer.data(), buffer.size());
+		if (!stream) return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(temporary, path, ec);
+	return !ec;
+}
+
+aurora::Catalog::Entry const* aurora::Catalog::find(std::string_view name, uint64_t size, int64_t mtime) const {
+	auto it = mEntries.find(name);
+	if (it == mEntries.end()) return nullptr;
+
+	Entry const& entry = it->second;
+	if (entry.size != size || entry.mtime != mtime) return nullptr;
+	return &entry;
+}
+
+std::optional<ObjlibHeader> aurora::Catalog::lookup_header(std::string_view name, uint64_t size, int64_t mtime) const {
+	Entry const* entry = find(name, size, mtime);
+	if (!entry) return std::nullopt;
+
+	// Entry ranges were validated on load
+	aurora::BinaryCursor cursor(mFile.data() + entry->offset, mFile.data() + entry->offset + entry->length);
+	if (cursor.remaining() < sizeof(ObjlibHeader)) return std::nullopt;
+	return cursor.read<ObjlibHeader>();
+}
+
+bool aurora::Catalog::lookup(std::string_view name, uint64_t size, int64_t mtime, Objlib& lib) const {
+	Entry const* entry = find(name, size, mtime);
+	if (!entry) return false;
+
+	try {
+		aurora::BinaryCursor cursor(mFile.data() + entry->offset, mFile.data() + entry->offset + entry->length);
+		ObjlibHeader storedHeader = cursor.read<ObjlibHeader>();
+		if (checkObjlibHeader(storedHeader) != ObjlibSupport::kSupported) return false;
+
+		lib.header = storedHeader;
+		lib.headerDefOffset = static_cast<size_t>(cursor.read<uint64_t>());
+		lib.originalName = read_name(cursor, lib.raw);
+
+		uint32_t libraryImportCount = cursor.read_u32();
+		for (uint32_t i = 0; i < libraryImportCount; ++i) {
+			LibraryImport o;
+			o.unknown0 = cursor.read_u32();
+			o.string = read_name(cursor, lib.raw);
+			lib.libraryImports.push_back(o);
+		}
+
+		uint32_t objectImportCount = cursor.read_u32();
+		for (uint32_t i = 0; i < objectImportCount; ++i) {
+			ObjectImport o;
+			o.type = cursor.read<ObjType>();
+			o.objName = read_name(cursor, lib.raw);
+			o.unknown0 = cursor.read_u32();
+			o.libraryName = read_name(cursor, lib.raw);
+			lib.objectImports.push_back(o);
+		}
+
+		uint32_t objectCount = cursor.read_u32();
+		for (uint32_t i = 0; i < objectCount; ++i) {
+			Object o;
+			o.type = cursor.read<ObjType>();
+			o.name = read_name(cursor, lib.raw);
+
+			auto location = cursor.record(2 * sizeof(uint32_t));
+			o.offset = location.u32();
+			o.length = location.u32();
+			if (o.offset > lib.raw.size() || lib.raw.size() - o.offset < o.length) throw aurora::TruncatedData("Catalog definition outside of objlib");
+
+			lib.objects.push_back(o);
+		}
+	}
+	catch (aurora::TruncatedData const&) {
+		lib.libraryImports.clear();
+		lib.objectImports.clear();
+		lib.objects.clear();
+		return false;
+	}
+
+	return true;
+}
\ No newline at end of file
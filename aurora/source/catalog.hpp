@@ -0,0 +1,51 @@
+#pragma once
+
+#include "mapped_file.hpp"
+#include "objlib.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+namespace aurora {
+	// Parsed objlib headers from a previous run, keyed by file name, size and modification time
+	// Lets startup skip any .pc file that hasn't changed since the catalog was written
+	class Catalog final {
+	public:
+		struct Record {
+			std::string_view name;
+			uint64_t size;
+			int64_t mtime;
+			ObjlibHeader header;
+			Objlib const* lib; // nullptr when the file isn't a supported objlib
+		};
+
+		// A missing, outdated or damaged catalog loads as empty
+		static Catalog load(std::filesystem::path const& path, std::string_view cacheDir);
+		static bool save(std::filesystem::path const& path, std::string_view cacheDir, std::span<Record const> records);
+
+		// Returns std::nullopt if the file isn't in the catalog or changed since it was stored
+		std::optional<ObjlibHeader> lookup_header(std::string_view name, uint64_t size, int64_t mtime) const;
+
+		// Fills every parsed field of `lib`, names are resolved against the already mapped `lib.raw`
+		// Returns false if the file isn't a supported objlib in the catalog or changed since it was stored
+		bool lookup(std::string_view name, uint64_t size, int64_t mtime, Objlib& lib) const;
+
+		size_t size() const { return mEntries.size(); }
+	private:
+		struct Entry {
+			uint64_t size;
+			int64_t mtime;
+			size_t offset;
+			size_t length;
+		};
+
+		Entry const* find(std::string_view name, uint64_t size, int64_t mtime) const;
+
+		MappedFile mFile;
+		std::unordered_map<std::string_view, Entry> mEntries; // Keys view into mFile
+	};
+}
\ No newline at end of file
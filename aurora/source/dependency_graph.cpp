@@ -0,0 +1,166 @@
+#include "dependency_graph.hpp"
+
+#include <algorithm>
+
+aurora::DependencyGraph::Adjacency aurora::DependencyGraph::Adjacency::build(size_t nodes, std::vector<std::pair<Id, Id>> edges) {
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+	Adjacency adjacency;
+	adjacency.starts.assign(nodes + 1, 0);
+	adjacency.targets.reserve(edges.size());
+
+	for (auto const& [from, to] : edges) {
+		++adjacency.starts[from + 1];
+		adjacency.targets.push_back(to);
+	}
+
+	for (size_t i = 0; i < nodes; ++i)
+		adjacency.starts[i + 1] += adjacency.starts[i];
+
+	return adjacency;
+}
+
+aurora::DependencyGraph::Id aurora::DependencyGraph::intern(std::string_view name) {
+	auto it = mSymbolIds.find(name);
+	if (it != mSymbolIds.end()) return it->second;
+
+	Id id = static_cast<Id>(mSymbols.size());
+	mSymbolIds.emplace(mSymbols.emplace_back(name), id);
+	mLibraryOfSymbol.push_back(kNone);
+	return id;
+}
+
+aurora::DependencyGraph::Id aurora::DependencyGraph::intern_library(std::string_view name) {
+	Id symbol = intern(name);
+	if (mLibraryOfSymbol[symbol] != kNone) return mLibraryOfSymbol[symbol];
+
+	Id id = static_cast<Id>(mLibraries.size());
+	mLibraries.push_back({ symbol, nullptr });
+	mLibraryOfSymbol[symbol] = id;
+	return id;
+}
+
+aurora::DependencyGraph aurora::DependencyGraph::build(std::span<Objlib const* const> libs) {
+	DependencyGraph graph;
+
+	// Loaded libraries and their definitions first, so every import below can resolve against them
+	std::vector<std::pair<Id, Id>> definitions;
+	for (Objlib const* lib : libs) {
+		Id library = graph.intern_library(lib->originalName);
+		graph.mLibraries[library].lib = lib;
+
+		for (uint32_t i = 0; i < lib->objects.size(); ++i) {
+			Id object = static_cast<Id>(graph.mObjects.size());
+			Id name = graph.intern(lib->objects[i].name);
+
+			// Duplicate names within one library resolve to the first definition
+			if (graph.mObjectIds.emplace((uint64_t(library) << 32) | name, object).second) {
+				graph.mObjects.push_back({ library, name, i });
+				definitions.emplace_back(library, object);
+			}
+		}
+	}
+
+	std::vector<std::pair<Id, Id>> dependencies;
+	std::vector<std::pair<Id, Id>> importers;
+	std::vector<std::pair<Id, Id>> libraryImporters;
+
+	for (Objlib const* lib : libs) {
+		Id importer = graph.find_library(lib->originalName);
+
+		for (LibraryImport const& import : lib->libraryImports) {
+			Id library = graph.intern_library(import.string);
+			dependencies.emplace_back(importer, library);
+			libraryImporters.emplace_back(library, importer);
+			if (!graph.mLibraries[library].lib) graph.mDangling.push_back({ importer, graph.mLibraries[library].name, kNone });
+		}
+
+		for (ObjectImport const& import : lib->objectImports) {
+			Id library = graph.intern_library(import.libraryName);
+			dependencies.emplace_back(importer, library);
+
+			Id object = graph.find_object(library, import.objName);
+			if (object != kNone) importers.emplace_back(object, importer);
+			else graph.mDangling.push_back({ importer, graph.intern(import.objName), library });
+		}
+	}
+
+	std::vector<std::pair<Id, Id>> dependents;
+	dependents.reserve(dependencies.size());
+	for (auto const& [from, to] : dependencies)
+		dependents.emplace_back(to, from);
+
+	size_t const libraryCount = graph.mLibraries.size();
+	graph.mDependencies = Adjacency::build(libraryCount, std::move(dependencies));
+	graph.mDependents = Adjacency::build(libraryCount, std::move(dependents));
+	graph.mImporters = Adjacency::build(graph.mObjects.size(), std::move(importers));
+	graph.mLibraryImporters = Adjacency::build(libraryCount, std::move(libraryImporters));
+	graph.mDefinitions = Adjacency::build(libraryCount, std::move(definitions));
+	return graph;
+}
+
+aurora::DependencyGraph::Id aurora::DependencyGraph::find_library(std::string_view name) const {
+	auto it = mSymbolIds.find(name);
+	if (it == mSymbolIds.end()) return kNone;
+	return mLibraryOfSymbol[it->second];
+}
+
+aurora::DependencyGraph::Id aurora::DependencyGraph::find_object(Id library, std::string_view name) const {
+	auto symbol = mSymbolIds.find(name);
+	if (library == kNone || symbol == mSymbolIds.end()) return kNone;
+
+	auto it = mObjectIds.find((uint64_t(library) << 32) | symbol->second);
+	return it == mObjectIds.end() ? kNone : it->second;
+}
+
+std::vector<aurora::DependencyGraph::Id> aurora::DependencyGraph::reach(std::span<Id const> roots, Adjacency const& edges) const {
+	std::vector<bool> seen(mLibraries.size(), false);
+	std::vector<Id> queue(roots.begin(), roots.end());
+
+	for (Id root : roots)
+		seen[root] = true;
+
+	// Roots sit at the front of the queue, everything after them was reached
+	for (size_t next = 0; next < queue.size(); ++next) {
+		for (Id target : edges.of(queue[next])) {
+			if (seen[target]) continue;
+			seen[target] = true;
+			queue.push_back(target);
+		}
+	}
+
+	queue.erase(queue.begin(), queue.begin() + roots.size());
+	return queue;
+}
+
+std::vector<aurora::DependencyGraph::Id> aurora::DependencyGraph::transitive_dependents(std::span<Id const> roots) const {
+	// Duplicate roots would be queued twice
+	std::vector<Id> unique(roots.begin(), roots.end());
+	std::sort(unique.begin(), unique.end());
+	unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+	return reach(unique, mDependents);
+}
+
+std::vector<aurora::DependencyGraph::Id> aurora::DependencyGraph::transitive_dependencies(Id library) const {
+	return reach({ &library, 1 }, mDependencies);
+}
+
+std::vector<aurora::DependencyGraph::Id> aurora::DependencyGraph::impact(Id object) const {
+	Id const library = mObjects[object].library;
+
+	// Only the direct importers of the object or of its whole library spread the change further
+	std::vector<Id> seeds(importers(object).begin(), importers(object).end());
+	seeds.insert(seeds.end(), library_importers(library).begin(), library_importers(library).end());
+	std::sort(seeds.begin(), seeds.end());
+	seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+	std::erase(seeds, library);
+
+	std::vector<Id> affected{ library };
+	affected.insert(affected.end(), seeds.begin(), seeds.end());
+
+	for (Id dependent : reach(seeds, mDependents))
+		if (dependent != library) affected.push_back(dependent);
+
+	return affected;
+}
\ No newline at end of file
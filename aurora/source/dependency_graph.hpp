@@ -0,0 +1,99 @@
+#pragma once
+
+#include "objlib.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace aurora {
+	// Library and object imports of every loaded objlib, resolved once
+	// Every name is interned to a dense symbol id and every edge list is a flat array per node, so dependents, closures
+	// and impact of an edit are O(edges) walks over integers instead of string compares across the whole cache
+	class DependencyGraph final {
+	public:
+		using Id = uint32_t;
+		static constexpr Id kNone = UINT32_MAX;
+
+		struct Library {
+			Id name; // Symbol
+			Objlib const* lib; // nullptr when the library is imported but not loaded
+		};
+
+		struct Object {
+			Id library;
+			Id name; // Symbol
+			uint32_t index; // Into lib->objects of its library
+		};
+
+		// An import nothing loaded provides
+		struct Dangling {
+			Id importer; // Library
+			Id name; // Symbol of the library, or of the object for object imports
+			Id library; // Library the object was imported from, kNone for library imports
+		};
+
+		// Names are copied, the graph outlives the mappings of `libs`
+		static DependencyGraph build(std::span<Objlib const* const> libs);
+
+		std::string_view name(Id symbol) const { return mSymbols[symbol]; }
+		Id find_library(std::string_view name) const;
+		Id find_object(Id library, std::string_view name) const;
+
+		std::span<Library const> libraries() const { return mLibraries; }
+		std::span<Object const> objects() const { return mObjects; }
+		std::span<Dangling const> dangling() const { return mDangling; }
+
+		// Libraries `library` imports from, either whole or single objects
+		std::span<Id const> dependencies(Id library) const { return mDependencies.of(library); }
+		// Libraries importing from `library`
+		std::span<Id const> dependents(Id library) const { return mDependents.of(library); }
+		// Libraries importing `object`
+		std::span<Id const> importers(Id object) const { return mImporters.of(object); }
+		// Libraries importing all of `library` through a library import
+		std::span<Id const> library_importers(Id library) const { return mLibraryImporters.of(library); }
+		// Objects defined by `library`
+		std::span<Id const> definitions(Id library) const { return mDefinitions.of(library); }
+
+		// Every library reachable from `roots` over dependent edges, roots excluded
+		std::vector<Id> transitive_dependents(std::span<Id const> roots) const;
+		// Every library reachable from `library` over dependency edges, itself excluded
+		std::vector<Id> transitive_dependencies(Id library) const;
+
+		// Libraries affected by changing `object`: its library, the libraries importing it or all of its library, and
+		// everything depending on those. Libraries that only import other objects of the same library aren't affected
+		std::vector<Id> impact(Id object) const;
+	private:
+		// Targets of node i are targets[starts[i], starts[i + 1])
+		struct Adjacency {
+			std::vector<uint32_t> starts;
+			std::vector<Id> targets;
+
+			static Adjacency build(size_t nodes, std::vector<std::pair<Id, Id>> edges);
+			std::span<Id const> of(Id node) const { return { targets.data() + starts[node], targets.data() + starts[node + 1] }; }
+		};
+
+		Id intern(std::string_view name);
+		Id intern_library(std::string_view name);
+		std::vector<Id> reach(std::span<Id const> roots, Adjacency const& edges) const;
+
+		std::deque<std::string> mSymbols; // Stable storage for the views in mSymbolIds
+		std::unordered_map<std::string_view, Id> mSymbolIds;
+		std::vector<Id> mLibraryOfSymbol; // kNone for symbols that don't name a library
+
+		std::vector<Library> mLibraries;
+		std::vector<Object> mObjects;
+		std::unordered_map<uint64_t, Id> mObjectIds; // Library id << 32 | name symbol
+		std::vector<Dangling> mDangling;
+
+		Adjacency mDependencies;
+		Adjacency mDependents;
+		Adjacency mImporters;
+		Adjacency mLibraryImporters;
+		Adjacency mDefinitions;
+	};
+}
\ No newline at end of file
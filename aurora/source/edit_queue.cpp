@@ -0,0 +1,65 @@
+#include "edit_queue.hpp"
+
+#include "file_patch.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+bool aurora::EditQueue::push(Edit edit) {
+	for (Edit& queued : mEdits) {
+		if (queued.file != edit.file) continue;
+
+		if (queued.offset == edit.offset && queued.size == edit.size) {
+			queued = std::move(edit);
+			return true;
+		}
+
+		bool overlaps = edit.offset < queued.offset + queued.size && queued.offset < edit.offset + edit.size;
+		if (overlaps) return false;
+	}
+
+	mEdits.push_back(std::move(edit));
+	return true;
+}
+
+std::vector<std::string> aurora::EditQueue::files() const {
+	std::vector<std::string> files;
+	for (Edit const& edit : mEdits)
+		files.push_back(edit.file);
+
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
+	return files;
+}
+
+aurora::EditQueue::Result aurora::EditQueue::apply() {
+	std::sort(mEdits.begin(), mEdits.end(), [](Edit const& a, Edit const& b) {
+		if (a.file != b.file) return a.file < b.file;
+		return a.offset < b.offset;
+	});
+
+	Result result;
+	std::vector<Edit> remaining;
+	std::vector<FilePatch> patches;
+
+	for (auto begin = mEdits.begin(); begin != mEdits.end();) {
+		auto end = std::find_if(begin, mEdits.end(), [&](Edit const& edit) { return edit.file != begin->file; });
+
+		patches.clear();
+		for (auto it = begin; it != end; ++it)
+			patches.push_back({ it->offset, it->size, it->data });
+
+		if (patch_file(begin->file, patches)) {
+			result.applied.push_back(begin->file);
+		}
+		else {
+			result.failed.push_back(begin->file);
+			std::move(begin, end, std::back_inserter(remaining));
+		}
+
+		begin = end;
+	}
+
+	mEdits = std::move(remaining);
+	return result;
+}
\ No newline at end of file
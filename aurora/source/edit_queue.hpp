@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace aurora {
+	// Record edits waiting to be written, across any number of records in any number of files
+	// Offsets and sizes always refer to the file as it is on disk, queued edits never shift each other
+	class EditQueue final {
+	public:
+		struct Edit {
+			std::string file;
+			size_t offset;
+			size_t size; // Of the record currently on disk
+			std::vector<std::byte> data;
+			std::string label;
+		};
+
+		struct Result {
+			std::vector<std::string> applied;
+			std::vector<std::string> failed; // Left unchanged on disk, their edits stay queued
+		};
+
+		// Replaces an already queued edit of the same record
+		// Returns false if the edit overlaps a different queued record of the same file
+		bool push(Edit edit);
+
+		void erase(size_t index) { mEdits.erase(mEdits.begin() + index); }
+		void clear() { mEdits.clear(); }
+
+		std::span<Edit const> edits() const { return mEdits; }
+		bool empty() const { return mEdits.empty(); }
+
+		// Every file with at least one queued edit, sorted
+		std::vector<std::string> files() const;
+
+		// Writes all edits of each file in a single pass, see aurora::patch_file
+		Result apply();
+	private:
+		std::vector<Edit> mEdits;
+	};
+}
\ No newline at end of file
@@ -13,11 +13,29 @@
 #include <imgui.h>
 #include <lua.hpp>
 
+#include "benchmarks.hpp"
+#include "binary_cursor.hpp"
+#include "backup_store.hpp"
+#include "binary_writer.hpp"
+#include "cache_index.hpp"
+#include "catalog.hpp"
+#include "dependency_graph.hpp"
+#include "edit_queue.hpp"
+#include "export_writer.hpp"
+#include "hash_cracker.hpp"
 #include "hashtable.hpp"
+#include "leaf.hpp"
+#include "objlib.hpp"
+#include "parallel.hpp"
+#include "pattern_search.hpp"
+#include "script_runner.hpp"
+#include "string_harvest.hpp"
+#include "trait_curve.hpp"
+#include "trigram_index.hpp"
+#include "usage_index.hpp"
 
 #include <vulpengine/vp_transform.hpp>
 
-#include <any>
 #include <algorithm>
 #include <array>
 #include <iostream>
@@ -27,7 +45,12 @@
 #include <optional>
 #include <fstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <cstdint>
+#include <charconv>
+#include <cfloat>
+#include <chrono>
+#include <format>
 
 #include <TextEditor.h>
 
@@ -53,6 +76,7 @@
 #include <assimp/postprocess.h>
 
 #include "vulpengine/experimental/vp_shader_program.hpp"
+#include <vulpengine/vp_util.hpp>
 
 #define AURORA_WIKI "http://thumper.anthofoxo.xyz/"
 
@@ -66,325 +90,131 @@
 #error "Unknown compiler"
 #endif
 
-uint32_t hash32(unsigned char const* array, unsigned int size) {
-	uint32_t h = 0x811c9dc5;
-
-	while (size > 0) {
-		size--;
-		h = (h ^ *array) * 0x1000193;
-		array++;
-	}
-
-	h *= 0x2001;
-	h = (h ^ (h >> 0x7)) * 0x9;
-	h = (h ^ (h >> 0x11)) * 0x21;
-
-	return h;
-}
-
-uint32_t readUint32(char** ptr) {
-	uint32_t value;
-	memcpy(&value, *ptr, sizeof(uint32_t));
-	*ptr += sizeof(uint32_t);
-	return value;
-}
-
-char readByte(char** ptr) {
-	char value;
-	memcpy(&value, *ptr, sizeof(char));
-	*ptr += sizeof(char);
-	return value;
-}
-
-std::string readString(char** ptr) {
-	uint32_t length = readUint32(ptr);
-	std::string string;
-	string.resize(length);
-	memcpy(string.data(), *ptr, length);
-	*ptr += length;
-	return string;
-}
-
-glm::vec3 readVec3(char** ptr) {
-	glm::vec3 data;
-	memcpy(&data, *ptr, sizeof(glm::vec3));
-	*ptr += sizeof(glm::vec3);
-	return data;
-}
-
-enum struct FileType : uint32_t {
-	kMeshX      =  6,
-	kObjlib     =  8,
-	kFsbTexture = 13,
-	kDdsTexture = 14,
-};
-
-enum struct ObjType : uint32_t {
-	kAnim = 0x5232f8f9,
-	kBend = 0x7dd6b7d8,
-	kBind = 0x570e17fa,
-	kCam = 0x8f86650f,
-	kCh = 0xadb02913,
-	kCond = 0x4945e860,
-	kDch = 0xac1abb2c,
-	kDec = 0x9ce604da,
-	kDsp = 0xacc2033e,
-	kEnt = 0xeae6beee,
-	kEnv = 0x3bbcc4ec,
-	kFlow = 0x86621b1e,
-	kFlt_0 = 0x6222e06f,
-	kFlt_1 = 0x993811f5,
-	kGameplay = 0xc2fd0a11,
-	kGate = 0xaa63a508,
-	kGrp = 0xc2aaec43,
-	kLeaf = 0xce7e85f6,
-	kLight = 0x711a2715,
-	kLvl = 0xbcd17473,
-	kMaster = 0x490780b9,
-	kMastering = 0x1a5812f6,
-	kMat = 0x7ba5c8e0,
-	kMesh = 0xbf69f115,
-	kObjlibGfx = 0x1ba51443,
-	kObjlibSequin = 0xb0954548,
-	kObjlibObj = 0x9d1c6219,
-	kObjlibLevel = 0x0b374d9e,
-	kObjlibAvatar = 0xe674624f,
-	kPath = 0x4890a3f6,
-	kPlayspace = 0x745dd78b,
-	kPulse = 0x230da622,
-	kSamp = 0x7aa8f390,
-	kSDraw_Drawer = 0xd3058b5d,
-	kSh = 0xcac934cf,
-	kSpn = 0xd897d5db,
-	kSt = 0xd955fdc6,
-	kSteer = 0xe7b3aadb,
-	kTex = 0x96ba8a70,
-	kVib = 0x799c45a7,
-	kVrSettings = 0x4f37349d,
-	kXfm_Xfmer = 0x7d9db5ef
-};
-
-struct ObjlibHeader {
-	FileType fileType;
-	ObjType objType;
-	uint32_t unknown0;
-	uint32_t unknown1;
-	uint32_t unknown2;
-};
-
-struct LibraryImport {
-	uint32_t unknown0;
-	std::string string;
-};
-
-struct ObjectImport {
-	ObjType type;
-	std::string objName;
-	uint32_t unknown0;
-	std::string libraryName;
-};
-
-struct Object {
-	ObjType type;
-	std::string name;
-};
-
-struct Objlib {
-	std::string originFile;
-
-
-	std::vector<char> raw;
-	size_t headerDefOffset; // Offset into raw data the object definitions start
-
-	ObjlibHeader header;
-	std::string originalName;
-	std::vector<LibraryImport> libraryImports;
-	std::vector<ObjectImport> objectImports;
-	std::vector<Object> objects;
-};
-
-
-enum struct TraitType : uint32_t {
-	kTraitInt = 0,
-	kTraitBool,
-	kTraitFloat,
-	kTraitColor,
-	kTraitObj,
-	kTraitVec3,
-	kTraitPath,
-	kTraitEnum,
-	kTraitAction,
-	kTraitObjVec,
-	kTraitString,
-	kTraitCue,
-	kTraitEvent,
-	kTraitSym,
-	kTraitList,
-	kTraitTraitPath,
-	kTraitQuat,
-	kTraitChildLib,
-	kTraitComponent,
-
-	kNumTraitTypes,
-};
-
-int failedCount = 0;
-
-#include <vulpengine/vp_util.hpp>
-
-std::optional<Objlib> readObjlib(char const* file) {
-	Objlib lib;
-
-	lib.originFile = file;
-
-	lib.raw = vulpengine::read_file(file).value();
-	char* const baseaddr = lib.raw.data();
-	char* ptr = lib.raw.data();
-
-
-	memcpy(&lib.header, ptr, sizeof(ObjlibHeader));
-	ptr += sizeof(ObjlibHeader);
-
-	if (lib.header.fileType == FileType::kMeshX) {
-		return std::nullopt;
-	}
-
-	if (lib.header.fileType != FileType::kObjlib) {
-		++failedCount;
-		return std::nullopt;
-	}
-
-	if (lib.header.objType == ObjType::kObjlibObj) {
-		++failedCount;
-		std::cout << "unsupported type " << file << '\n';
+std::unordered_map<std::string, Objlib> kMap;
+std::string kCacheDir;
+std::string filter;
 
-		return std::nullopt;
-	}
+// Known names for hashes: the built in list, hashes.txt and the names of every loaded objlib
+// hashes.txt and hashes.bin live next to config.lua, hashes.bin is rebuilt whenever a name is missing from it
+static constexpr char const* kHashNamesPath = "hashes.txt";
+static constexpr char const* kHashDictionaryPath = "hashes.bin";
+static aurora::HashDictionary kHashes;
 
-	if (lib.header.objType == ObjType::kObjlibGfx) {
-		// nothing here?
-	}
+static void harvestHashNames(Objlib const& lib) {
+	kHashes.add(lib.originalName);
 
-	// Not very sure what this value is
-	if (lib.header.objType == ObjType::kObjlibLevel) {
-		uint32_t unknown;
-		memcpy(&unknown, ptr, sizeof(uint32_t));
-		ptr += sizeof(uint32_t);
-	}
+	for (auto const& import : lib.libraryImports)
+		kHashes.add(import.string);
 
-	// Not very sure what this value is
-	if (lib.header.objType == ObjType::kObjlibAvatar) {
-		uint32_t unknown;
-		memcpy(&unknown, ptr, sizeof(uint32_t));
-		ptr += sizeof(uint32_t);
+	for (auto const& import : lib.objectImports) {
+		kHashes.add(import.objName);
+		kHashes.add(import.libraryName);
 	}
 
-	// Not very sure what this value is
-	if (lib.header.objType == ObjType::kObjlibSequin) {
-		uint32_t unknown;
-		memcpy(&unknown, ptr, sizeof(uint32_t));
-		ptr += sizeof(uint32_t);
-	}
+	for (auto const& object : lib.objects)
+		kHashes.add(object.name);
+}
 
-	uint32_t libraryImportCount = readUint32(&ptr);
-	lib.libraryImports.reserve(libraryImportCount);
+void loadHashes() {
+	kHashes = aurora::HashDictionary::load(kHashDictionaryPath);
 
-	for (uint32_t i = 0; i < libraryImportCount; ++i) {
-		LibraryImport o;
-		o.unknown0 = readUint32(&ptr);
-		o.string = readString(&ptr);
-		lib.libraryImports.emplace_back(o);
-	}
+	for (std::string_view name : aurora::builtin_hash_names())
+		kHashes.add(name);
 
-	lib.originalName = readString(&ptr);
+	kHashes.add_file(kHashNamesPath);
 
-	uint32_t objectImportCount = readUint32(&ptr);
-	lib.objectImports.reserve(objectImportCount);
+	for (auto const& [k, v] : kMap)
+		harvestHashNames(v);
 
-	for (uint32_t i = 0; i < objectImportCount; ++i) {
-		ObjectImport o;
-		o.type = static_cast<ObjType>(readUint32(&ptr));
-		o.objName = readString(&ptr);
-		o.unknown0 = readUint32(&ptr);
-		o.libraryName = readString(&ptr);
-		lib.objectImports.push_back(o);
+	if (kHashes.pending() != 0) {
+		kHashes.build();
+		kHashes.save(kHashDictionaryPath);
 	}
+}
 
-	uint32_t objectCount = readUint32(&ptr);
-	lib.objects.reserve(objectCount);
+// Every hash shown without a name so far, the Hash Cracker's default targets
+static std::unordered_set<uint32_t> kUnresolved;
 
-	for (uint32_t i = 0; i < objectCount; ++i) {
-		Object o;
-		o.type = static_cast<ObjType>(readUint32(&ptr));
-		o.name = readString(&ptr);
-		lib.objects.push_back(o);
-	}
+// Remembers a name for good, it's appended to hashes.txt
+static bool learnHashName(std::string_view name) {
+	if (!kHashes.add(name)) return false;
 
-	lib.headerDefOffset = (uintptr_t)(ptr - baseaddr);
+	kUnresolved.erase(aurora::hash32(name));
 
-	return lib;
+	std::ofstream file(kHashNamesPath, std::ios::app);
+	file << name << '\n';
+	return true;
 }
 
-std::unordered_map<std::string, Objlib> kMap;
-std::string kCacheDir;
-std::string filter;
-
 void displayHash(char const* label, uint32_t hash) {
-	char const* match = aurora::lookupHash(hash);
+	char const* match = kHashes.find(hash);
+	if (!match) kUnresolved.insert(hash);
 
 	if (match) ImGui::LabelText(label, "%s", match);
 	else ImGui::LabelText(label, "%08X", hash);
 }
 
-static void writeU8(std::vector<uint8_t>& buffer, uint8_t data) {
-	buffer.push_back(data);
+// Every length prefixed string of the cache becomes a name, runs in the background after startup
+static aurora::StringHarvest kHarvest;
+static std::optional<aurora::StringHarvest::Result> kHarvestReport; // `strings` only holds the ones that explained a shown hash
+static size_t kHarvestNewNames = 0;
+static bool viewHarvest = false;
+static bool viewUsages = false;
+static bool viewDependencies = false;
+static std::string usageQuery;
+
+static void startHarvest() {
+	std::vector<std::filesystem::path> files;
+	files.reserve(kMap.size());
+	for (auto const& [k, v] : kMap)
+		files.push_back(v.originFile);
+
+	kHarvest.start(std::move(files));
 }
 
-static void writeU32(std::vector<uint8_t>& buffer, uint32_t data) {
-	for (int i = 0; i < sizeof(uint32_t); ++i)
-		buffer.push_back(0);
+static void finishHarvest(aurora::StringHarvest::Result result) {
+	// Whoever cancelled it either starts a new one or the previous report is still the latest complete one
+	if (result.cancelled) return;
 
-	memcpy(buffer.data() + buffer.size() - sizeof(uint32_t), &data, sizeof(uint32_t));
-}
+	kHarvestNewNames = 0;
+	std::vector<aurora::StringHarvest::String> explained;
 
-static void writeStr(std::vector<uint8_t>& buffer, std::string_view data) {
-	writeU32(buffer, static_cast<uint32_t>(data.size()));
-	for (auto c : data)
-		buffer.push_back(c);
-}
+	for (auto& string : result.strings) {
+		bool unresolved = kUnresolved.erase(string.hash) != 0;
+		if (!kHashes.add(string.text)) continue;
 
-static void writeF32(std::vector<uint8_t>& buffer, float data) {
-	for (int i = 0; i < sizeof(float); ++i)
-		buffer.push_back(0);
+		++kHarvestNewNames;
+		if (unresolved) explained.push_back(std::move(string));
+	}
 
-	memcpy(buffer.data() + buffer.size() - sizeof(float), &data, sizeof(float));
-}
+	// Saved so the next start knows them without harvesting first
+	if (kHashes.pending() != 0) {
+		kHashes.build();
+		kHashes.save(kHashDictionaryPath);
+	}
 
-static void writeVec3(std::vector<uint8_t>& buffer, glm::vec3 const& data) {
-	writeF32(buffer, data.x);
-	writeF32(buffer, data.y);
-	writeF32(buffer, data.z);
+	result.strings = std::move(explained);
+	kHarvestReport = std::move(result);
 }
 
-void InjectIntoPc(std::vector<uint8_t>& raw, std::string originFile, size_t originSize, size_t originOffset) {
-	std::string backup = originFile + std::string(".bak");
-	if (!std::filesystem::exists(backup))
-		std::filesystem::copy(originFile, backup);
-
-	std::vector<char> original = vulpengine::read_file(originFile.c_str()).value();
-	std::vector<char> final;
-	final.resize(original.size() - originSize + raw.size());
-
-	memcpy(final.data(), original.data(), originOffset);
-	memcpy(final.data() + originOffset, raw.data(), raw.size());
-	memcpy(final.data() + originOffset + raw.size(), original.data() + originOffset + originSize + 1, original.size() - originOffset - originSize);
-
-	std::ofstream stream(originFile, std::ofstream::binary);
-	stream.write(final.data(), final.size());
-	stream.close();
-
-	tinyfd_messageBox("Injected", "Changed injected, Application will exit", "ok", "info", 1);
-	std::exit(0);
+// Edits are only written once the user applies the whole queue from the Pending Edits window
+static aurora::EditQueue kEdits;
+static aurora::CacheSearch kSearch;
+
+// Every version of the files we changed, lives next to config.lua
+static aurora::BackupStore kBackups("backups");
+static bool viewEdits = false;
+static bool viewBackups = false;
+static bool viewCensus = false;
+static bool viewCracker = false;
+static aurora::HashCracker kCracker;
+
+void QueueInjectIntoPc(std::vector<uint8_t> const& raw, std::string originFile, size_t originSize, size_t originOffset, std::string label) {
+	auto bytes = std::as_bytes(std::span(raw));
+	if (!kEdits.push({ std::move(originFile), originOffset, originSize, { bytes.begin(), bytes.end() }, std::move(label) }))
+		tinyfd_messageBox("Inject failed", "The record overlaps another queued edit of the same file", "ok", "error", 1);
+	else
+		viewEdits = true;
 }
 
 struct Samp final {
@@ -428,10 +258,9 @@ struct Samp final {
 		ImGui::Separator();
 		ImGui::PushStyleColor(ImGuiCol_Button, { 1,0,0,1 });
 		ImGui::PushStyleColor(ImGuiCol_ButtonHovered, { 1, .3f, .3f,1 });
-		if (ImGui::Button("Inject")) {
-			std::vector<uint8_t> raw;
-			serialize(raw);
-			InjectIntoPc(raw, originFile, originSize, originOffset);
+		if (ImGui::Button("Queue edit")) {
+			std::vector<uint8_t> raw = serialize();
+			QueueInjectIntoPc(raw, originFile, originSize, originOffset, "Samp " + filepath);
 		}
 		ImGui::PopStyleColor(2);
 	}
@@ -442,41 +271,50 @@ struct Samp final {
 		originSize = size;
 	}
 
-	char* deserialize(char* ptr) {
-		memcpy(header, ptr, sizeof(header)); ptr += sizeof(header);
-		hash = readUint32(&ptr);
-		playMode = readString(&ptr);
-		unknown0 = readUint32(&ptr);
-		filepath = readString(&ptr);
-		memcpy(unknown1, ptr, sizeof(unknown1)); ptr += sizeof(unknown1);
-		volume = std::bit_cast<float>(readUint32(&ptr));
-		pitch = std::bit_cast<float>(readUint32(&ptr));
-		pan = std::bit_cast<float>(readUint32(&ptr));
-		offset = std::bit_cast<float>(readUint32(&ptr));
-		channel = readString(&ptr);
-		return ptr;
+	void deserialize(aurora::BinaryCursor& cursor) {
+		auto head = cursor.record(sizeof(header) + sizeof(hash));
+		head.bytes(header, sizeof(header));
+		hash = head.u32();
+		playMode = cursor.read_string();
+		unknown0 = cursor.read_u32();
+		filepath = cursor.read_string();
+
+		auto mix = cursor.record(sizeof(unknown1) + 4 * sizeof(float));
+		mix.bytes(unknown1, sizeof(unknown1));
+		volume = mix.f32();
+		pitch = mix.f32();
+		pan = mix.f32();
+		offset = mix.f32();
+
+		channel = cursor.read_string();
 	}
 
-	void serialize(std::vector<uint8_t>& data) {
-		writeU32(data, header[0]);
-		writeU32(data, header[1]);
-		writeU32(data, header[2]);
-		writeU32(data, hash);
-		writeStr(data, playMode);
-		writeU32(data, unknown0);
-		writeStr(data, filepath);
-		writeU8(data, unknown1[0]);
-		writeU8(data, unknown1[1]);
-		writeU8(data, unknown1[2]);
-		writeU8(data, unknown1[3]);
-		writeU8(data, unknown1[4]);
-		writeF32(data, volume);
-		writeF32(data, pitch);
-		writeF32(data, pan);
-		writeF32(data, offset);
-		writeStr(data, channel);
+	size_t serialized_size() const {
+		return sizeof(header) + sizeof(hash)
+			+ aurora::BinaryWriter::string_size(playMode)
+			+ sizeof(unknown0)
+			+ aurora::BinaryWriter::string_size(filepath)
+			+ sizeof(unknown1) + 4 * sizeof(float)
+			+ aurora::BinaryWriter::string_size(channel);
 	}
 
+	std::vector<uint8_t> serialize() const {
+		std::vector<uint8_t> data(serialized_size());
+		aurora::BinaryWriter writer(std::as_writable_bytes(std::span(data)));
+
+		writer.write_bytes(header, sizeof(header));
+		writer.write_u32(hash);
+		writer.write_string(playMode);
+		writer.write_u32(unknown0);
+		writer.write_string(filepath);
+		writer.write_bytes(unknown1, sizeof(unknown1));
+		writer.write_f32(volume);
+		writer.write_f32(pitch);
+		writer.write_f32(pan);
+		writer.write_f32(offset);
+		writer.write_string(channel);
+		return data;
+	}
 };
 
 struct Spn final {
@@ -532,69 +370,370 @@ struct Spn final {
 		ImGui::Separator();
 		ImGui::PushStyleColor(ImGuiCol_Button, { 1,0,0,1 });
 		ImGui::PushStyleColor(ImGuiCol_ButtonHovered, { 1, .3f, .3f,1 });
-		if (ImGui::Button("Inject")) {
-			std::vector<uint8_t> raw;
-			serialize(raw);
-			InjectIntoPc(raw, originFile, originSize, originOffset);
-
+		if (ImGui::Button("Queue edit")) {
+			std::vector<uint8_t> raw = serialize();
+			QueueInjectIntoPc(raw, originFile, originSize, originOffset, "Spn " + name);
 		}
 		ImGui::PopStyleColor(2);
 	}
 
-	char* deserialize(char* ptr) {
-		memcpy(header, ptr, sizeof(header)); ptr += sizeof(header);
-		hash0 = readUint32(&ptr);
-		hash1 = readUint32(&ptr);
-		unknown0 = readUint32(&ptr);
-		name = readString(&ptr);
-		constraint = readString(&ptr);
-		translation = readVec3(&ptr);
-		rotationx = readVec3(&ptr);
-		rotationy = readVec3(&ptr);
-		rotationz = readVec3(&ptr);
-		scale = readVec3(&ptr);
-		unknown1 = readUint32(&ptr);
-		objlibpath = readString(&ptr);
-		bucketType = readString(&ptr);
-		return ptr;
+	void deserialize(aurora::BinaryCursor& cursor) {
+		auto head = cursor.record(sizeof(header) + 3 * sizeof(uint32_t));
+		head.bytes(header, sizeof(header));
+		hash0 = head.u32();
+		hash1 = head.u32();
+		unknown0 = head.u32();
+		name = cursor.read_string();
+		constraint = cursor.read_string();
+
+		auto transform = cursor.record(5 * sizeof(glm::vec3) + sizeof(uint32_t));
+		translation = transform.read<glm::vec3>();
+		rotationx = transform.read<glm::vec3>();
+		rotationy = transform.read<glm::vec3>();
+		rotationz = transform.read<glm::vec3>();
+		scale = transform.read<glm::vec3>();
+		unknown1 = transform.u32();
+
+		objlibpath = cursor.read_string();
+		bucketType = cursor.read_string();
+	}
+
+	size_t serialized_size() const {
+		return sizeof(header) + 3 * sizeof(uint32_t)
+			+ aurora::BinaryWriter::string_size(name)
+			+ aurora::BinaryWriter::string_size(constraint)
+			+ 5 * sizeof(glm::vec3) + sizeof(unknown1)
+			+ aurora::BinaryWriter::string_size(objlibpath)
+			+ aurora::BinaryWriter::string_size(bucketType);
 	}
 
-	void serialize(std::vector<uint8_t>& data) {
-		writeU32(data, header[0]);
-		writeU32(data, header[1]);
-		writeU32(data, header[2]);
-		writeU32(data, hash0);
-		writeU32(data, hash1);
-		writeU32(data, unknown0);
-		writeStr(data, name);
-		writeStr(data, constraint);
-		writeVec3(data, translation);
-		writeVec3(data, rotationx);
-		writeVec3(data, rotationy);
-		writeVec3(data, rotationz);
-		writeVec3(data, scale);
-		writeU32(data, unknown1);
-		writeStr(data, objlibpath);
-		writeStr(data, bucketType);
+	std::vector<uint8_t> serialize() const {
+		std::vector<uint8_t> data(serialized_size());
+		aurora::BinaryWriter writer(std::as_writable_bytes(std::span(data)));
+
+		writer.write_bytes(header, sizeof(header));
+		writer.write_u32(hash0);
+		writer.write_u32(hash1);
+		writer.write_u32(unknown0);
+		writer.write_string(name);
+		writer.write_string(constraint);
+		writer.write(translation);
+		writer.write(rotationx);
+		writer.write(rotationy);
+		writer.write(rotationz);
+		writer.write(scale);
+		writer.write_u32(unknown1);
+		writer.write_string(objlibpath);
+		writer.write_string(bucketType);
+		return data;
 	}
 };
 
 static std::optional<Spn> spnParsed = std::nullopt;
 static std::optional<Samp> sampParsed = std::nullopt;
 
+// Decoded once when a leaf is opened, the parser window only draws it
+struct ParsedLeaf {
+	aurora::Leaf leaf;
+	aurora::LeafCurves curves;
+	std::string error; // Why decoding stopped early, empty if the whole record decoded
+};
+
+static std::optional<ParsedLeaf> leafParsed = std::nullopt;
+
+// Objects of every type across the whole cache, taken from the definition index
+struct CensusRow {
+	ObjType type;
+	size_t declared = 0;
+	size_t located = 0;
+	size_t measured = 0; // Located with a known length
+	uint64_t bytes = 0; // Of measured definitions
+};
+
+static std::vector<CensusRow> kCensus;
+
+static void updateCensus() {
+	std::unordered_map<ObjType, CensusRow> rows;
+
+	for (auto const& [k, v] : kMap) {
+		for (Object const& object : v.objects) {
+			CensusRow& row = rows[object.type];
+			row.type = object.type;
+			++row.declared;
+
+			if (object.offset != 0) {
+				++row.located;
+				if (object.length != 0) ++row.measured;
+				row.bytes += object.length;
+			}
+		}
+	}
+
+	kCensus.clear();
+	for (auto const& [type, row] : rows)
+		kCensus.push_back(row);
+
+	std::sort(kCensus.begin(), kCensus.end(), [](CensusRow const& a, CensusRow const& b) { return a.declared > b.declared; });
+}
+
+// Where every object name hash occurs across the loaded objlibs, built in the background after startup and every reload
+static aurora::UsageIndex kUsages;
+static std::vector<std::string> kUsageFiles; // originFile of every file index in kUsages
+static aurora::UsageIndexBuilder kUsageBuilder;
+static bool kUsagesStale = false;
+
+static void startUsages() {
+	std::vector<std::filesystem::path> files;
+	std::vector<uint32_t> keys;
+
+	for (auto const& [k, v] : kMap) {
+		files.push_back(v.originFile);
+
+		for (Object const& object : v.objects)
+			keys.push_back(aurora::hash32(object.name));
+	}
+
+	kUsageBuilder.start(std::move(files), std::move(keys));
+	kUsagesStale = false;
+}
+
+static void finishUsages(aurora::UsageIndex index) {
+	kUsageFiles.clear();
+	for (std::filesystem::path const& file : kUsageBuilder.files())
+		kUsageFiles.push_back(file.string());
+
+	kUsages = std::move(index);
+}
+
+// Imports of every loaded objlib resolved against the others, holds pointers into kMap so it's rebuilt whenever kMap changes
+static aurora::DependencyGraph kGraph;
+
+static void rebuildGraph() {
+	std::vector<Objlib const*> libs;
+	libs.reserve(kMap.size());
+	for (auto const& [k, v] : kMap)
+		libs.push_back(&v);
+
+	kGraph = aurora::DependencyGraph::build(libs);
+}
+
+// One line of the Obj Libs tree, the tree is drawn from a flat list of these so only the visible lines cost anything
+struct ObjlibRow {
+	enum Kind : uint8_t {
+		kLibrary,
+		kOrigin,
+		kJump,
+		kLibraryImports,
+		kLibraryImport,
+		kObjectImports,
+		kObjectImport,
+		kObjects,
+		kObject,
+	};
+
+	Kind kind;
+	uint32_t lib; // Into ObjlibBrowser::libs
+	uint32_t item; // Into the import or object list of the row kind
+};
+
+// Libs of kMap sorted by name, indexed by their names, imports and object names for the filter
+// Holds pointers into kMap so it's rebuilt whenever kMap changes, rows are rebuilt when the filter or an open node changes
+struct ObjlibBrowser {
+	enum OpenBits : uint8_t {
+		kOpenLibrary = 1 << 0,
+		kOpenLibraryImports = 1 << 1,
+		kOpenObjectImports = 1 << 2,
+		kOpenObjects = 1 << 3,
+	};
+
+	struct Lib {
+		std::string_view key; // Of kMap
+		Objlib* lib;
+	};
+
+	std::vector<Lib> libs; // Index document ids
+	std::vector<uint8_t> open; // OpenBits per lib
+	aurora::TrigramIndex index;
+	aurora::TrigramFilter filter;
+	std::vector<ObjlibRow> rows;
+	bool rowsStale = true;
+
+	void rebuild() {
+		// Open nodes survive a reload of their objlib, it stays in the same kMap node
+		std::unordered_map<Objlib const*, uint8_t> previous;
+		for (size_t i = 0; i < libs.size(); ++i)
+			if (open[i]) previous[libs[i].lib] = open[i];
+
+		libs.clear();
+		libs.reserve(kMap.size());
+		for (auto& [k, v] : kMap)
+			libs.push_back({ k, &v });
+
+		std::sort(libs.begin(), libs.end(), [](Lib const& a, Lib const& b) {
+			return std::tie(a.lib->originalName, a.key) < std::tie(b.lib->originalName, b.key);
+		});
+
+		index = {};
+		std::vector<std::string_view> fields;
+		for (Lib const& entry : libs) {
+			Objlib const& lib = *entry.lib;
+
+			fields.clear();
+			fields.push_back(lib.originalName);
+			for (auto const& import : lib.libraryImports)
+				fields.push_back(import.string);
+			for (auto const& import : lib.objectImports) {
+				fields.push_back(import.objName);
+				fields.push_back(import.libraryName);
+			}
+			for (auto const& object : lib.objects)
+				fields.push_back(object.name);
+
+			index.add(fields);
+		}
+		index.build();
+
+		open.assign(libs.size(), 0);
+		for (size_t i = 0; i < libs.size(); ++i) {
+			auto it = previous.find(libs[i].lib);
+			if (it != previous.end()) open[i] = it->second;
+		}
+
+		filter.invalidate();
+		rowsStale = true;
+	}
+
+	void update(std::string_view text) {
+		if (filter.update(index, text)) rowsStale = true;
+		if (!rowsStale) return;
+
+		rows.clear();
+		for (uint32_t lib : filter.results()) {
+			rows.push_back({ ObjlibRow::kLibrary, lib, 0 });
+			if (!(open[lib] & kOpenLibrary)) continue;
+
+			rows.push_back({ ObjlibRow::kOrigin, lib, 0 });
+			rows.push_back({ ObjlibRow::kJump, lib, 0 });
+
+			auto children = [&](size_t count, OpenBits bit, ObjlibRow::Kind node, ObjlibRow::Kind item) {
+				if (count == 0) return;
+				rows.push_back({ node, lib, 0 });
+				if (!(open[lib] & bit)) return;
+
+				for (uint32_t i = 0; i < count; ++i)
+					rows.push_back({ item, lib, i });
+			};
+
+			Objlib const& v = *libs[lib].lib;
+			children(v.libraryImports.size(), kOpenLibraryImports, ObjlibRow::kLibraryImports, ObjlibRow::kLibraryImport);
+			children(v.objectImports.size(), kOpenObjectImports, ObjlibRow::kObjectImports, ObjlibRow::kObjectImport);
+			children(v.objects.size(), kOpenObjects, ObjlibRow::kObjects, ObjlibRow::kObject);
+		}
+
+		rowsStale = false;
+	}
+
+	// Applies the open state a tree node reported, rows follow on the next update
+	void set_open(uint32_t lib, OpenBits bit, bool isOpen) {
+		if (static_cast<bool>(open[lib] & bit) == isOpen) return;
+		open[lib] ^= bit;
+		rowsStale = true;
+	}
+};
+
+static ObjlibBrowser kObjlibBrowser;
+
+// Lives next to config.lua
+static constexpr char const* kCatalogPath = "catalog.bin";
+
+aurora::CacheIndex kCacheIndex;
+
 void loadObjLibs() {
-	for (auto const& entry : std::filesystem::directory_iterator(kCacheDir)) {
-		std::string file = entry.path().filename().string();
+	struct Parsed {
+		size_t index;
+		Objlib lib;
+	};
+
+	// Each worker only ever touches its own results
+	std::vector<std::vector<Parsed>> results(aurora::worker_count());
+	std::atomic_bool catalogOutdated = false;
+
+	{
+		aurora::Catalog catalog = aurora::Catalog::load(kCatalogPath, kCacheDir);
+		kCacheIndex = aurora::CacheIndex::build(kCacheDir, catalog);
+		if (catalog.size() != kCacheIndex.entries.size()) catalogOutdated = true;
+
+		aurora::parallel_for(kCacheIndex.entries.size(), [&](size_t index, unsigned worker) {
+			aurora::CacheEntry const& entry = kCacheIndex.entries[index];
+			if (!entry.probed) return;
+			if (!entry.cached) catalogOutdated = true;
+
+			if (checkObjlibHeader(entry.header) == ObjlibSupport::kFailed) {
+				++failedCount;
+
+				if (entry.header.fileType == FileType::kObjlib)
+					std::cout << ("unsupported type " + entry.path.string() + '\n'); // Single write, this runs on many threads
+			}
 
-		if (entry.path().extension() != ".pc") continue;
+			// Meshes and textures are never opened here
+			if (!entry.is_objlib()) return;
 
-		std::optional<Objlib> lib = readObjlib(entry.path().string().c_str());
-		if (lib.has_value()) {
-			kMap[entry.path().stem().string()] = lib.value();
+			auto raw = aurora::MappedFile::open(entry.path);
+			if (!raw) return;
 
-		
+			Objlib lib;
+			lib.originFile = entry.path.string();
+			lib.raw = std::move(raw.value());
+
+			if (entry.cached && catalog.lookup(entry.name, entry.size, entry.mtime, lib)) {
+				results[worker].push_back({ index, std::move(lib) });
+				return;
+			}
+
+			catalogOutdated = true;
+
+			std::optional<Objlib> parsed = parseObjlib(std::move(lib.originFile), std::move(lib.raw));
+			if (parsed.has_value()) {
+				indexObjlibDefinitions(parsed.value());
+				results[worker].push_back({ index, std::move(parsed.value()) });
+			}
+			else
+				++failedCount; // Truncated or otherwise malformed
+		});
+	}
+
+	std::vector<Parsed*> merged;
+	for (auto& workerResults : results)
+		for (auto& parsed : workerResults)
+			merged.push_back(&parsed);
+
+	// Sorted so the merge below always inserts in the same order
+	std::sort(merged.begin(), merged.end(), [](Parsed const* a, Parsed const* b) { return a->index < b->index; });
+
+	if (catalogOutdated) {
+		std::vector<Objlib const*> libs(kCacheIndex.entries.size(), nullptr);
+		for (Parsed const* parsed : merged)
+			libs[parsed->index] = &parsed->lib;
+
+		std::vector<aurora::Catalog::Record> records;
+		records.reserve(kCacheIndex.entries.size());
+
+		for (size_t i = 0; i < kCacheIndex.entries.size(); ++i) {
+			aurora::CacheEntry const& entry = kCacheIndex.entries[i];
+			if (!entry.probed) continue;
+			records.push_back({ entry.name, entry.size, entry.mtime, entry.header, libs[i] });
 		}
+
+		aurora::Catalog::save(kCatalogPath, kCacheDir, records);
 	}
+
+	for (Parsed* parsed : merged)
+		kMap.insert_or_assign(kCacheIndex.entries[parsed->index].path.stem().string(), std::move(parsed->lib));
+
+	updateCensus();
+	startUsages();
+	rebuildGraph();
+	kObjlibBrowser.rebuild();
 }
 
 void dumpHashes() {
@@ -612,6 +751,186 @@ void dumpHashes() {
 	file.close();
 }
 
+static char const* fileTypeName(FileType type) {
+	switch (type) {
+	case FileType::kMeshX: return "mesh";
+	case FileType::kObjlib: return "objlib";
+	case FileType::kFsbTexture: return "fsb_texture";
+	case FileType::kDdsTexture: return "dds_texture";
+	default: return nullptr;
+	}
+}
+
+// One writer per cache file, filled in parallel and concatenated in cache order
+static void exportCacheEntry(aurora::CacheEntry const& entry, aurora::ExportWriter& out) {
+	using Column = aurora::ExportWriter::Column;
+	std::string const file = entry.name;
+
+	out.begin("file");
+	out.text(Column::kFile, file);
+	out.number(Column::kLength, entry.size);
+	if (entry.probed) {
+		if (char const* name = fileTypeName(entry.header.fileType)) out.text(Column::kType, name);
+		else out.number(Column::kType, static_cast<uint64_t>(entry.header.fileType));
+	}
+	out.end();
+
+	if (entry.is_objlib()) {
+		auto it = kMap.find(entry.path.stem().string());
+		if (it == kMap.end()) return;
+		Objlib const& lib = it->second;
+
+		auto typeColumn = [&](ObjType type) {
+			if (char const* name = objTypeName(type)) out.text(Column::kType, name);
+			else out.hash(Column::kType, static_cast<uint32_t>(type));
+		};
+
+		out.begin("objlib");
+		out.text(Column::kFile, file);
+		typeColumn(lib.header.objType);
+		out.text(Column::kName, lib.originalName);
+		out.hash(Column::kHash, aurora::hash32(lib.originalName));
+		out.number(Column::kOffset, static_cast<uint64_t>(lib.headerDefOffset));
+		out.end();
+
+		for (LibraryImport const& import : lib.libraryImports) {
+			out.begin("library_import");
+			out.text(Column::kFile, file);
+			out.text(Column::kLibrary, import.string);
+			out.number(Column::kUnknown, uint64_t{ import.unknown0 });
+			out.end();
+		}
+
+		for (ObjectImport const& import : lib.objectImports) {
+			out.begin("object_import");
+			out.text(Column::kFile, file);
+			typeColumn(import.type);
+			out.text(Column::kName, import.objName);
+			out.text(Column::kLibrary, import.libraryName);
+			out.hash(Column::kHash, aurora::hash32(import.objName));
+			out.number(Column::kUnknown, uint64_t{ import.unknown0 });
+			out.end();
+		}
+
+		for (Object const& object : lib.objects) {
+			out.begin("object");
+			out.text(Column::kFile, file);
+			typeColumn(object.type);
+			out.text(Column::kName, object.name);
+			out.hash(Column::kHash, aurora::hash32(object.name));
+			if (object.offset != 0) {
+				out.number(Column::kOffset, uint64_t{ object.offset });
+				if (object.length != 0) out.number(Column::kLength, uint64_t{ object.length }); // Left empty when the end isn't known
+			}
+			out.end();
+
+			if (object.offset == 0) continue;
+
+			// Decoded records, a malformed one is left out rather than failing the whole export
+			try {
+				aurora::BinaryCursor cursor(lib.raw.bytes(), object.offset);
+
+				if (object.type == ObjType::kSamp) {
+					Samp samp;
+					samp.deserialize(cursor);
+
+					out.begin("samp");
+					out.text(Column::kFile, file);
+					out.text(Column::kName, object.name);
+					out.hash(Column::kHash, samp.hash);
+					out.number(Column::kOffset, uint64_t{ object.offset });
+					out.number(Column::kLength, static_cast<uint64_t>(cursor.offset() - object.offset));
+					out.number(Column::kUnknown, uint64_t{ samp.unknown0 });
+					out.text(Column::kPlayMode, samp.playMode);
+					out.text(Column::kFilepath, samp.filepath);
+					out.text(Column::kChannel, samp.channel);
+					out.number(Column::kVolume, samp.volume);
+					out.number(Column::kPitch, samp.pitch);
+					out.number(Column::kPan, samp.pan);
+					out.number(Column::kStart, samp.offset);
+					out.end();
+				}
+				else if (object.type == ObjType::kSpn) {
+					Spn spn;
+					spn.deserialize(cursor);
+
+					out.begin("spn");
+					out.text(Column::kFile, file);
+					out.text(Column::kName, spn.name);
+					out.hash(Column::kHash, spn.hash0);
+					out.number(Column::kOffset, uint64_t{ object.offset });
+					out.number(Column::kLength, static_cast<uint64_t>(cursor.offset() - object.offset));
+					out.number(Column::kUnknown, uint64_t{ spn.unknown0 });
+					out.text(Column::kConstraint, spn.constraint);
+					out.text(Column::kLibrary, spn.objlibpath);
+					out.text(Column::kBucketType, spn.bucketType);
+					out.number(Column::kPositionX, spn.translation.x);
+					out.number(Column::kPositionY, spn.translation.y);
+					out.number(Column::kPositionZ, spn.translation.z);
+					out.number(Column::kScaleX, spn.scale.x);
+					out.number(Column::kScaleY, spn.scale.y);
+					out.number(Column::kScaleZ, spn.scale.z);
+
+					float const rotation[9] = {
+						spn.rotationx.x, spn.rotationx.y, spn.rotationx.z,
+						spn.rotationy.x, spn.rotationy.y, spn.rotationy.z,
+						spn.rotationz.x, spn.rotationz.y, spn.rotationz.z,
+					};
+					out.json_array("rotation", rotation);
+					out.end();
+				}
+			}
+			catch (aurora::TruncatedData const&) {}
+		}
+	}
+	else if (entry.is_mesh()) {
+		auto mesh = thumper::MeshFile::from_file(entry.path);
+		if (!mesh) return;
+
+		out.begin("mesh");
+		out.text(Column::kFile, file);
+		out.number(Column::kMeshes, static_cast<uint64_t>(mesh->meshes.size()));
+		out.number(Column::kVertices, static_cast<uint64_t>(mesh->vertices.size()));
+		out.number(Column::kTriangles, static_cast<uint64_t>(mesh->triangles.size()));
+		out.end();
+
+		for (size_t i = 0; i < mesh->meshes.size(); ++i) {
+			out.begin("lod");
+			out.text(Column::kFile, file);
+			out.number(Column::kIndex, static_cast<uint64_t>(i));
+			out.number(Column::kVertices, uint64_t{ mesh->meshes[i].vertexCount });
+			out.number(Column::kTriangles, uint64_t{ mesh->meshes[i].triangleCount });
+			out.end();
+		}
+	}
+}
+
+// Every file of the cache with its headers, imports, objects, decoded records and mesh stats
+static void exportCatalog() {
+	constexpr char const* kJsonPath = "cache.jsonl";
+	constexpr char const* kCsvPath = "cache.csv";
+
+	auto begin = std::chrono::steady_clock::now();
+
+	std::vector<aurora::ExportWriter> parts(kCacheIndex.entries.size());
+	aurora::parallel_for(parts.size(), [&](size_t index, unsigned) {
+		exportCacheEntry(kCacheIndex.entries[index], parts[index]);
+	});
+
+	size_t rows = 0;
+	for (aurora::ExportWriter const& part : parts)
+		rows += part.rows();
+
+	if (!aurora::write_export(kJsonPath, kCsvPath, parts)) {
+		tinyfd_messageBox("Export failed", "Could not write cache.jsonl or cache.csv", "ok", "error", 1);
+		return;
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	std::string message = std::format("Wrote {} rows of {} files to {} and {} in {:.2f}s\nObject lengths are left empty unless the next declared object was located, samp and spn rows hold decoded lengths", rows, parts.size(), kJsonPath, kCsvPath, seconds);
+	tinyfd_messageBox("Export finished", message.c_str(), "ok", "info", 1);
+}
+
 void loadConfig() {
 	bool hasStoredCachePath = false;
 
@@ -639,39 +958,8 @@ void loadConfig() {
 	}
 }
 
-size_t split(const std::string& txt, std::vector<std::string>& strs, char ch) {
-	size_t pos = txt.find(ch);
-	size_t initialPos = 0;
-	strs.clear();
-
-	// Decompose statement
-	while (pos != std::string::npos) {
-		strs.push_back(txt.substr(initialPos, pos - initialPos));
-		initialPos = pos + 1;
-
-		pos = txt.find(ch, initialPos);
-	}
-
-	// Add the last one
-	strs.push_back(txt.substr(initialPos, std::min(pos, txt.size()) - initialPos + 1));
-
-	return strs.size();
-}
-
 TextEditor editor;
-lua_State* L = nullptr;
-lua_State* T = nullptr;
-
-void hookfunc(lua_State* L, lua_Debug* ar) {
-	lua_getinfo(L, "l", ar); // Get ar->currentline
-	//printf("Executing line: %d\n", ar->currentline);
-
-	TextEditor::ErrorMarkers marker;
-	marker.insert(std::make_pair(ar->currentline, "Current line"));
-	editor.SetErrorMarkers(marker);
-
-	lua_yield(L, 0); // Yield, only works when using `lua_resume` and with 0 return values
-}
+static aurora::ScriptRunner kScript;
 
 static void dumpstack(lua_State* L) {
 	int top = lua_gettop(L);
@@ -697,14 +985,71 @@ static void dumpstack(lua_State* L) {
 	}
 }
 
+// aurora.usages(nameOrHash) returns { { file = "...", offset = n }, ... }
+static int luaUsages(lua_State* L) {
+	uint32_t hash = 0;
+
+	if (lua_type(L, 1) == LUA_TNUMBER) {
+		hash = static_cast<uint32_t>(luaL_checkinteger(L, 1));
+	}
+	else {
+		size_t length = 0;
+		char const* name = luaL_checklstring(L, 1, &length);
+		hash = aurora::hash32({ name, length });
+	}
+
+	std::vector<aurora::UsageIndex::Usage> usages = kUsages.find(hash);
+	lua_createtable(L, static_cast<int>(usages.size()), 0);
+
+	for (size_t i = 0; i < usages.size(); ++i) {
+		lua_createtable(L, 0, 2);
+		lua_pushstring(L, kUsageFiles[usages[i].file].c_str());
+		lua_setfield(L, -2, "file");
+		lua_pushinteger(L, usages[i].offset);
+		lua_setfield(L, -2, "offset");
+		lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+	}
+
+	return 1;
+}
+
+static void openAuroraLib(lua_State* L) {
+	lua_newtable(L);
+	lua_pushcfunction(L, luaUsages);
+	lua_setfield(L, -2, "usages");
+	lua_setglobal(L, "aurora");
+}
+
 static Objlib* selection = nullptr;
 
+// Parses an objlib again after its file changed on disk, views into its old mapping are gone afterwards
+static void reloadObjlib(std::string const& originFile) {
+	std::string key = std::filesystem::path(originFile).stem().string();
+
+	auto it = kMap.find(key);
+	if (it != kMap.end()) it->second.raw = {};
+
+	std::optional<Objlib> lib = readObjlib(originFile.c_str());
+	if (lib) {
+		indexObjlibDefinitions(lib.value());
+		harvestHashNames(lib.value());
+		kMap.insert_or_assign(key, std::move(lib.value())); // Same node, `selection` stays valid
+	}
+	else if (it != kMap.end()) {
+		if (selection == &it->second) selection = nullptr;
+		kMap.erase(it);
+	}
+
+	updateCensus();
+	rebuildGraph();
+	kObjlibBrowser.rebuild();
+	kUsagesStale = true;
+}
+
 // loadedMesh is already in memory, skip reload, we only load the original to preserve _unknownField4
 std::optional<thumper::MeshFile> attempt_obj_pc_replace(thumper::MeshFile& loadedMesh, std::string obj, std::string pc) {
 	if (!std::string_view(pc).ends_with(".pc")) return std::nullopt;
 
-	std::string const backupPath = pc + ".bak";
-
 	// Import obj
 	Assimp::Importer importer;
 	aiScene const* scene = importer.ReadFile(obj.c_str(), aiProcess_Triangulate | aiProcess_RemoveComponent | aiProcess_GenNormals | aiProcess_ImproveCacheLocality | aiProcess_SortByPType | aiProcess_GenUVCoords | aiProcess_OptimizeMeshes | aiProcess_OptimizeGraph);
@@ -715,8 +1060,7 @@ std::optional<thumper::MeshFile> attempt_obj_pc_replace(thumper::MeshFile& loade
 	aiMesh* mesh = scene->mMeshes[0];
 
 	thumper::MeshFile pcMesh;
-	pcMesh.meshes.resize(1);
-	pcMesh.meshes[0].vertices.reserve(mesh->mNumVertices);
+	pcMesh.vertices.reserve(mesh->mNumVertices);
 
 	// Store vertices
 	for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
@@ -726,11 +1070,11 @@ std::optional<thumper::MeshFile> attempt_obj_pc_replace(thumper::MeshFile& loade
 		if (mesh->GetNumUVChannels() > 0) v.texcoord = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][1].y };
 		v.normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
 		v.color = { 0, 0, 0, 0 };
-		pcMesh.meshes[0].vertices.push_back(v);
+		pcMesh.vertices.push_back(v);
 	}
 
 	// Store triangles
-	pcMesh.meshes[0].triangles.reserve(mesh->mNumFaces);
+	pcMesh.triangles.reserve(mesh->mNumFaces);
 
 	for (unsigned int iFace = 0; iFace < mesh->mNumFaces; iFace++) {
 		aiFace face = mesh->mFaces[iFace];
@@ -741,91 +1085,120 @@ std::optional<thumper::MeshFile> attempt_obj_pc_replace(thumper::MeshFile& loade
 		t.elements[1] = face.mIndices[1];
 		t.elements[2] = face.mIndices[2];
 
-		pcMesh.meshes[0].triangles.push_back(t);
+		pcMesh.triangles.push_back(t);
 	}
 
-	// Preserve _unknownField4
-	pcMesh.meshes[0]._unknownField4 = loadedMesh.meshes[0]._unknownField4;
+	// Single LOD over everything imported, preserve _unknownField4
+	pcMesh.meshes.push_back({
+		.firstVertex = 0,
+		.vertexCount = static_cast<uint32_t>(pcMesh.vertices.size()),
+		.firstTriangle = 0,
+		.triangleCount = static_cast<uint32_t>(pcMesh.triangles.size()),
+		._unknownField4 = loadedMesh.meshes[0]._unknownField4
+	});
 
-	// Make backup if needed
-	if (!std::filesystem::exists(backupPath))
-		std::filesystem::copy(pc, backupPath);
+	if (!kBackups.snapshot(pc)) return std::nullopt;
 
-	pcMesh.to_file(pc);
+	if (!pcMesh.to_file(pc)) return std::nullopt;
 
 	return pcMesh;
 }
 
-#include "vulpengine/experimental/vp_mesh.hpp"
+static std::string versionLabel(aurora::BackupStore::Version const& version) {
+	auto time = std::chrono::sys_seconds(std::chrono::seconds(version.time));
+	return std::format("Version {}, {:%Y-%m-%d %H:%M} UTC, {} bytes", version.number, time, version.size);
+}
 
 struct MeshPreview final {
-	// Uploads the thumper mesh into gpu memory and calculates a few constants from the data
-	void update_mesh(thumper::Mesh const& mesh) {
-		vulpengine::experimental::Buffer vertexBuffer = {{
-			.content = std::as_bytes(std::span(mesh.vertices)),
-			.flags = GL_NONE,
-			.label = "Thumper Preview Vertex Buffer"
-		}};
-
-		vulpengine::experimental::Buffer indexBuffer = {{
-			.content = std::as_bytes(std::span(mesh.triangles)),
-			.flags = GL_NONE,
-			.label = "Thumper Preview Index Buffer"
-		}};
-
-		vulpengine::experimental::VertexArray vertexArray = {{
-			.buffers = std::array{
-				decltype(vertexArray)::BufferInfo{ .buffer = vertexBuffer, .offset = 0, .stride = sizeof(thumper::Vertex), .divisor = 0 },
-			},
-			.attributes = std::array{
-				decltype(vertexArray)::AttributeInfo{.size = 3, .type = GL_FLOAT,        .relativeoffset = offsetof(thumper::Vertex, position), .bindingindex = 0 },
-				decltype(vertexArray)::AttributeInfo{.size = 3, .type = GL_FLOAT,        .relativeoffset = offsetof(thumper::Vertex, normal),   .bindingindex = 0 },
-				decltype(vertexArray)::AttributeInfo{.size = 2, .type = GL_FLOAT,        .relativeoffset = offsetof(thumper::Vertex, texcoord), .bindingindex = 0 },
-				decltype(vertexArray)::AttributeInfo{.size = 4, .type = GL_UNSIGNED_INT, .relativeoffset = offsetof(thumper::Vertex, color),    .bindingindex = 0 },
-			},
-			.indexBuffer = vulpengine::experimental::wrap_cref(indexBuffer),
-			.label = "Thumper Preview Vertex Array"
-		}};
-
-		mMesh = {{
-			.vertexArray = std::move(vertexArray),
-			.buffers = std::array{
-				vulpengine::experimental::wrap_rvref(vertexBuffer),
-				vulpengine::experimental::wrap_rvref(indexBuffer),
-			},
-			.mode = GL_TRIANGLES,
-			.count = static_cast<GLsizei>(mesh.triangles.size() * 3),
-			.type = GL_UNSIGNED_SHORT,
-		}};
+	MeshPreview() = default;
+	MeshPreview(MeshPreview const&) = delete;
+	MeshPreview& operator=(MeshPreview const&) = delete;
+
+	MeshPreview(MeshPreview&& other) noexcept {
+		*this = std::move(other);
+	}
+
+	MeshPreview& operator=(MeshPreview&& other) noexcept {
+		std::swap(mVertexArray, other.mVertexArray);
+		std::swap(mBuffers, other.mBuffers);
+		std::swap(mMesh, other.mMesh);
+		std::swap(mGeometryAverage, other.mGeometryAverage);
+		std::swap(mLargestVertexDistance, other.mLargestVertexDistance);
+		return *this;
+	}
+
+	~MeshPreview() {
+		// Zero names are silently ignored
+		glDeleteVertexArrays(1, &mVertexArray);
+		glDeleteBuffers(2, mBuffers);
+	}
+
+	// Uploads every LOD of the file into one vertex and one index buffer
+	// Switching LODs afterwards only changes the draw range, nothing is uploaded again
+	void upload(thumper::MeshFile const& file) {
+		glCreateBuffers(2, mBuffers);
+		glObjectLabel(GL_BUFFER, mBuffers[0], -1, "Thumper Preview Vertex Buffer");
+		glObjectLabel(GL_BUFFER, mBuffers[1], -1, "Thumper Preview Index Buffer");
+
+		// Storage can't be zero sized
+		glNamedBufferStorage(mBuffers[0], std::max<size_t>(1, std::as_bytes(std::span(file.vertices)).size()), file.vertices.data(), GL_NONE);
+		glNamedBufferStorage(mBuffers[1], std::max<size_t>(1, std::as_bytes(std::span(file.triangles)).size()), file.triangles.data(), GL_NONE);
+
+		glCreateVertexArrays(1, &mVertexArray);
+		glObjectLabel(GL_VERTEX_ARRAY, mVertexArray, -1, "Thumper Preview Vertex Array");
+		glVertexArrayVertexBuffer(mVertexArray, 0, mBuffers[0], 0, sizeof(thumper::Vertex));
+		glVertexArrayElementBuffer(mVertexArray, mBuffers[1]);
+
+		glVertexArrayAttribFormat(mVertexArray, 0, 3, GL_FLOAT,         GL_FALSE, offsetof(thumper::Vertex, position));
+		glVertexArrayAttribFormat(mVertexArray, 1, 3, GL_FLOAT,         GL_FALSE, offsetof(thumper::Vertex, normal));
+		glVertexArrayAttribFormat(mVertexArray, 2, 2, GL_FLOAT,         GL_FALSE, offsetof(thumper::Vertex, texcoord));
+		// solid.glsl reads the color as an integer input, a float format there is undefined
+		glVertexArrayAttribIFormat(mVertexArray, 3, 4, GL_UNSIGNED_BYTE, offsetof(thumper::Vertex, color));
+
+		for (GLuint attribute = 0; attribute < 4; ++attribute) {
+			glEnableVertexArrayAttrib(mVertexArray, attribute);
+			glVertexArrayAttribBinding(mVertexArray, attribute, 0);
+		}
+	}
+
+	// Selects the LOD to draw and calculates a few constants from its data
+	void select_mesh(thumper::MeshFile const& file, int index) {
+		mMesh = file.meshes[index];
 
 		// Calculate geometry center and distances
 		mLargestVertexDistance = 0.0f;
 		mGeometryAverage = {};
 
-		for (thumper::Vertex const& v : mesh.vertices) {
+		for (thumper::Vertex const& v : file.vertices_of(mMesh)) {
 			float maxCoord = glm::max(glm::max(glm::abs(v.position[0]), glm::abs(v.position[1])), glm::abs(v.position[2]));
 			if (maxCoord > mLargestVertexDistance) mLargestVertexDistance = maxCoord;
 			mGeometryAverage += v.position;
 		}
 
-		mGeometryAverage /= static_cast<float>(mesh.vertices.size());
+		mGeometryAverage /= static_cast<float>(mMesh.vertexCount);
+	}
+
+	// Triangle indices are relative to their LOD, the base vertex moves them onto its range of the shared buffer
+	void draw() const {
+		glBindVertexArray(mVertexArray);
+		glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(mMesh.triangleCount * 3), GL_UNSIGNED_SHORT, reinterpret_cast<void const*>(mMesh.firstTriangle * sizeof(thumper::Triangle)), static_cast<GLint>(mMesh.firstVertex));
+		glBindVertexArray(0);
 	}
 
 	glm::vec3 mGeometryAverage{};
 	float mLargestVertexDistance = 0.0f;
-	vulpengine::experimental::Mesh mMesh;
+
+	GLuint mVertexArray = 0;
+	GLuint mBuffers[2] = {};
+	thumper::Mesh mMesh{};
 };
 
 struct MeshWorkspace {
 	void init() {
-		for (auto const& entry : std::filesystem::directory_iterator(kCacheDir)) {
-			if (entry.path().extension() != ".pc") continue;
-
-			auto content = thumper::MeshFile::from_file(entry.path());
-			if (!content) continue;
-
-			mFiles.emplace_back(entry.path().filename().generic_string());
-		}
+		// The index only knows the header words, no geometry is decoded until a mesh is selected
+		for (aurora::CacheEntry const& entry : kCacheIndex.entries)
+			if (entry.is_mesh())
+				mFiles.emplace_back(entry.name);
 
 		mShaderProgramSolid = {{ .file = "solid.glsl" }};
 		mShaderProgramGrid = {{ .file = "grid.glsl" }};
@@ -865,33 +1238,35 @@ struct MeshWorkspace {
 				auto pMesh = scene.mMeshes[0];
 
 				// Allocate containers
-				thumper::Mesh& pcMeshOut = mLoadedMesh.meshes[mMeshIndex];
-				pMesh->mVertices = new aiVector3D[pcMeshOut.vertices.size()];
-				pMesh->mNumVertices = pcMeshOut.vertices.size();
-				pMesh->mTextureCoords[0] = new aiVector3D[pcMeshOut.vertices.size()];
-				pMesh->mNumUVComponents[0] = pcMeshOut.vertices.size();
+				thumper::Mesh const& pcMeshOut = mLoadedMesh.meshes[mMeshIndex];
+				std::span<thumper::Vertex const> pcVertices = mLoadedMesh.vertices_of(pcMeshOut);
+				std::span<thumper::Triangle const> pcTriangles = mLoadedMesh.triangles_of(pcMeshOut);
+				pMesh->mVertices = new aiVector3D[pcVertices.size()];
+				pMesh->mNumVertices = pcVertices.size();
+				pMesh->mTextureCoords[0] = new aiVector3D[pcVertices.size()];
+				pMesh->mNumUVComponents[0] = pcVertices.size();
 
 				// Copy vertex data
-				for (auto itr = pcMeshOut.vertices.begin(); itr != pcMeshOut.vertices.end(); ++itr) {
+				for (auto itr = pcVertices.begin(); itr != pcVertices.end(); ++itr) {
 					const auto& v = itr->position;
 					const auto& t = itr->texcoord;
-					pMesh->mVertices[itr - pcMeshOut.vertices.begin()] = aiVector3D(v[0], v[1], v[2]);
-					pMesh->mTextureCoords[0][itr - pcMeshOut.vertices.begin()] = aiVector3D(t[0], t[1], 0);
+					pMesh->mVertices[itr - pcVertices.begin()] = aiVector3D(v[0], v[1], v[2]);
+					pMesh->mTextureCoords[0][itr - pcVertices.begin()] = aiVector3D(t[0], t[1], 0);
 				}
 
 				// Allocate containers
-				pMesh->mFaces = new aiFace[pcMeshOut.triangles.size()];
-				pMesh->mNumFaces = pcMeshOut.triangles.size();
+				pMesh->mFaces = new aiFace[pcTriangles.size()];
+				pMesh->mNumFaces = pcTriangles.size();
 
 				// Copy triangle data
-				for (int i = 0; i < pcMeshOut.triangles.size(); ++i) {
+				for (int i = 0; i < pcTriangles.size(); ++i) {
 					aiFace& face = pMesh->mFaces[i];
 					face.mIndices = new unsigned int[3];
 					face.mNumIndices = 3;
 
-					face.mIndices[0] = pcMeshOut.triangles[i].elements[0];
-					face.mIndices[1] = pcMeshOut.triangles[i].elements[1];
-					face.mIndices[2] = pcMeshOut.triangles[i].elements[2];
+					face.mIndices[0] = pcTriangles[i].elements[0];
+					face.mIndices[1] = pcTriangles[i].elements[1];
+					face.mIndices[2] = pcTriangles[i].elements[2];
 				}
 
 				std::string exportPath = kCacheDir + "/" + mSelected + "." + std::to_string(mMeshIndex) + ".obj";
@@ -904,15 +1279,15 @@ struct MeshWorkspace {
 				
 			}
 
-			ImGui::BeginDisabled(!mHasBackup);
+			ImGui::BeginDisabled(mVersions.empty());
 
 			if (ImGui::Button("Restore Backup")) {
 				std::filesystem::path current = kCacheDir + "/" + mSelected;
-				std::filesystem::path backup = kCacheDir + "/" + mSelected + ".bak";
 
-				std::filesystem::copy_file(backup, current, std::filesystem::copy_options::overwrite_existing);
-				std::filesystem::remove(backup);
-				mHasBackup = false;
+				if (!kBackups.restore(current, mVersions[mRestoreVersion].number))
+					tinyfd_messageBox("Restore failed", "The backup is incomplete or the file couldn't be written", "ok", "error", 1);
+
+				update_versions();
 
 				try {
 					update_preview(mSelected);
@@ -922,6 +1297,19 @@ struct MeshWorkspace {
 				}
 			}
 
+			if (!mVersions.empty()) {
+				ImGui::SameLine();
+				ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
+
+				std::string preview = versionLabel(mVersions[mRestoreVersion]);
+				if (ImGui::BeginCombo("##Version", preview.c_str())) {
+					for (int i = 0; i < static_cast<int>(mVersions.size()); ++i) {
+						if (ImGui::Selectable(versionLabel(mVersions[i]).c_str(), i == mRestoreVersion)) mRestoreVersion = i;
+					}
+					ImGui::EndCombo();
+				}
+			}
+
 			ImGui::EndDisabled();
 
 			if (ImGui::Button("Replace Mesh LODs")) {
@@ -935,10 +1323,12 @@ struct MeshWorkspace {
 
 					if (!optNewMesh) ImGui::OpenPopup("InvalidMeshInput");
 					else {
-						mLoadedMesh = optNewMesh.value();
+						mLoadedMesh = std::move(optNewMesh.value());
 						mMeshIndex = 0;
 						mPreview = MeshPreview();
-						mPreview->update_mesh(mLoadedMesh.meshes[mMeshIndex]);
+						mPreview->upload(mLoadedMesh);
+						update_versions();
+						mPreview->select_mesh(mLoadedMesh, mMeshIndex);
 					}
 				}
 			}
@@ -956,15 +1346,14 @@ struct MeshWorkspace {
 
 			ImGui::LabelText("Meshes in file", "%d", mLoadedMesh.meshes.size());
 
-			if (ImGui::SliderInt("Mesh Index", &mMeshIndex, 0, mLoadedMesh.meshes.size() - 1)) {
-				mPreview = MeshPreview();
-				mPreview->update_mesh(mLoadedMesh.meshes[mMeshIndex]);
+			if (ImGui::SliderInt("Mesh Index", &mMeshIndex, 0, mLoadedMesh.meshes.size() - 1) && mPreview) {
+				mPreview->select_mesh(mLoadedMesh, mMeshIndex);
 			}
 
 			for (auto const& info : mLoadedMesh.meshes) {
 				ImGui::Separator();
-				ImGui::LabelText("Vertex Count", "%d", info.vertices.size());
-				ImGui::LabelText("Triangle Count", "%d", info.triangles.size());
+				ImGui::LabelText("Vertex Count", "%u", info.vertexCount);
+				ImGui::LabelText("Triangle Count", "%u", info.triangleCount);
 				ImGui::LabelText("_unknownField4", "%hu", info._unknownField4);
 			}
 		}
@@ -973,27 +1362,34 @@ struct MeshWorkspace {
 		if (ImGui::Begin("Mesh Workspace - Meshes")) {
 			ImGui::LabelText("Mesh Count", "%d", mFiles.size());
 
-			for (auto const& string : mFiles) {
-				ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_Leaf;
-				if (mSelected == string) flags |= ImGuiTreeNodeFlags_Selected;
+			// Sorted by path once at init, the clipper only submits the visible names
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(mFiles.size()));
 
-				ImGui::TreeNodeEx(string.c_str(), flags);
+			while (clipper.Step()) {
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+					std::string const& string = mFiles[i];
 
-				if (ImGui::IsItemActivated()) {
-					mSelected = string;
+					ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_Leaf;
+					if (mSelected == string) flags |= ImGuiTreeNodeFlags_Selected;
 
-					// Check for a backup file
-					mHasBackup = std::filesystem::exists(kCacheDir + "/" + mSelected + ".bak");
+					ImGui::TreeNodeEx(string.c_str(), flags);
 
-					try {
-						update_preview(mSelected);
-					}
-					catch (std::runtime_error const&) {
-						mPreview = {};
+					if (ImGui::IsItemActivated()) {
+						mSelected = string;
+
+						update_versions();
+
+						try {
+							update_preview(mSelected);
+						}
+						catch (std::runtime_error const&) {
+							mPreview = {};
+						}
 					}
-				}
 
-				ImGui::TreePop();
+					ImGui::TreePop();
+				}
 			}
 
 		}
@@ -1012,6 +1408,11 @@ struct MeshWorkspace {
 		ImGui::End();
 	}
 
+	void update_versions() {
+		mVersions = kBackups.versions(kCacheDir + "/" + mSelected);
+		mRestoreVersion = 0; // The oldest version is the unmodified file
+	}
+
 	void update_preview(std::string const& source) {
 		if (source.empty()) {
 			mPreview = {};
@@ -1026,13 +1427,14 @@ struct MeshWorkspace {
 			return;
 		}
 
-		mLoadedMesh = thumpermesh.value();
+		mLoadedMesh = std::move(thumpermesh.value());
 
 		// Make sure we don't try to load meshes past the count
-		if (mMeshIndex >= thumpermesh->meshes.size()) mMeshIndex = thumpermesh->meshes.size() - 1;
+		if (mMeshIndex >= mLoadedMesh.meshes.size()) mMeshIndex = mLoadedMesh.meshes.size() - 1;
 
 		mPreview = MeshPreview();
-		mPreview->update_mesh(mLoadedMesh.meshes[mMeshIndex]);
+		mPreview->upload(mLoadedMesh);
+		mPreview->select_mesh(mLoadedMesh, mMeshIndex);
 	}
 
 	void draw_preview(int width, int height) {
@@ -1106,11 +1508,11 @@ struct MeshWorkspace {
 		cwmode ^= mFlipWinding;
 		if(cwmode) glFrontFace(GL_CW);
 
-		mPreview->mMesh.draw();
+		mPreview->draw();
 		
 		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 		mShaderProgramSolid.push_3f("uColor", 1.0f, 1.0f, 1.0f);
-		mPreview->mMesh.draw();
+		mPreview->draw();
 		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 		glFrontFace(GL_CCW);
 
@@ -1127,7 +1529,8 @@ struct MeshWorkspace {
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	}
 
-	bool mHasBackup = false;
+	std::vector<aurora::BackupStore::Version> mVersions;
+	int mRestoreVersion = 0;
 	bool mFlipWinding = false;
 	bool mFlipAxis = false;
 	int mMeshIndex = 0;
@@ -1154,6 +1557,8 @@ int main(int argc, char* argv[]) {
 	loadConfig();
 
 	loadObjLibs();
+	loadHashes();
+	startHarvest();
 
 	glfwInit();
 
@@ -1189,11 +1594,14 @@ int main(int argc, char* argv[]) {
 
 	bool viewHasher = false;
 	bool viewBpms = false;
+	bool viewBenchmark = false;
+	std::string benchmarkReport;
 
 	bool showImguiDemo = false;
 	bool workspaceMesh = false;
 
 	MemoryEditor memedit;
+	memedit.ReadOnly = true; // Objlibs are viewed through read only file mappings
 	
 	editor.SetText("function doPrint()\n\tprint(\"Aurora\")\nend\n\nfor i = 0, 10, 1 do\n\tdoPrint()\nend");
 
@@ -1206,6 +1614,17 @@ int main(int argc, char* argv[]) {
 
 		ImGui::DockSpaceOverViewport();
 
+		if (auto result = kHarvest.take())
+			finishHarvest(std::move(result.value()));
+
+		if (kUsagesStale)
+			startUsages();
+
+		// A script on the worker thread may be reading the index, a new one is published once that script ends
+		if (!kScript.running_on_worker())
+			if (auto index = kUsageBuilder.take())
+				finishUsages(std::move(index.value()));
+
 		if (ImGui::BeginMainMenuBar()) {
 			if (ImGui::BeginMenu("File")) {
 				if (ImGui::MenuItem("Quit", "Alt+F4", nullptr))
@@ -1215,9 +1634,51 @@ int main(int argc, char* argv[]) {
 
 			if (ImGui::BeginMenu("Tools")) {
 				ImGui::MenuItem("Hasher", nullptr, &viewHasher);
+				ImGui::MenuItem("Hash Cracker", nullptr, &viewCracker);
+				ImGui::MenuItem("String Harvest", nullptr, &viewHarvest);
+				ImGui::MenuItem("Find Usages", nullptr, &viewUsages);
+				ImGui::MenuItem("Dependencies", nullptr, &viewDependencies);
 				ImGui::MenuItem("Level BPMs", nullptr, &viewBpms);
+				ImGui::MenuItem("Pending Edits", nullptr, &viewEdits);
+				ImGui::MenuItem("Backups", nullptr, &viewBackups);
+				ImGui::MenuItem("Object Census", nullptr, &viewCensus);
 				if (ImGui::MenuItem("Dump hashes", nullptr, nullptr))
 					dumpHashes();
+				if (ImGui::MenuItem("Export catalog", nullptr, nullptr))
+					exportCatalog();
+
+				if (ImGui::MenuItem("Benchmark readers", nullptr, nullptr)) {
+					std::vector<Objlib const*> libs;
+					libs.reserve(kMap.size());
+					for (auto const& [k, v] : kMap)
+						libs.push_back(&v);
+
+					benchmarkReport = aurora::benchmark_readers(libs);
+					std::cout << benchmarkReport;
+					viewBenchmark = true;
+				}
+
+				if (ImGui::MenuItem("Benchmark leaf decoding", nullptr, nullptr)) {
+					std::vector<Objlib const*> libs;
+					libs.reserve(kMap.size());
+					for (auto const& [k, v] : kMap)
+						libs.push_back(&v);
+
+					benchmarkReport = aurora::benchmark_leaf_decoding(libs);
+					std::cout << benchmarkReport;
+					viewBenchmark = true;
+				}
+
+				if (ImGui::MenuItem("Benchmark mesh writers", nullptr, nullptr)) {
+					std::vector<std::filesystem::path> paths;
+					for (aurora::CacheEntry const& entry : kCacheIndex.entries)
+						if (entry.is_mesh())
+							paths.push_back(entry.path);
+
+					benchmarkReport = aurora::benchmark_mesh_writers(paths);
+					std::cout << benchmarkReport;
+					viewBenchmark = true;
+				}
 
 				if (ImGui::MenuItem("Thumper Wiki", nullptr, nullptr)) {
 					SystemOpenURL(AURORA_WIKI);
@@ -1241,77 +1702,159 @@ int main(int argc, char* argv[]) {
 
 		{
 			editor.SetLanguageDefinition(TextEditor::LanguageDefinition::Lua());
+
+			static int mode = 0;
+			static int budget = 0;
+			static float budgetMs = 8.0f;
+			static int budgetInstructions = 100000;
+			// Markers are only rebuilt when the shown line or state changes, not on every hook call
+			static int markedLine = -1;
+			static aurora::ScriptRunner::State markedState = aurora::ScriptRunner::State::kIdle;
+
+			// Runs even while the window is hidden
+			bool wasRunning = kScript.running();
+			auto scriptBudget = budget == 0 ? aurora::ScriptRunner::Budget::kTime : aurora::ScriptRunner::Budget::kInstructions;
+			kScript.update(scriptBudget, budgetMs, static_cast<uint64_t>(budgetInstructions));
+
+			if (wasRunning && kScript.state() == aurora::ScriptRunner::State::kFailed)
+				std::cerr << kScript.error() << '\n';
+
 			if (ImGui::Begin("Script")) {
-		
-		
-				if (ImGui::Button("Run")) {
-					L = luaL_newstate();
-					luaL_openlibs(L);
-		
-					T = lua_newthread(L);
-					lua_sethook(T, hookfunc, LUA_MASKCOUNT, 1);
-		
-					if (luaL_loadstring(T, editor.GetText().c_str()) != LUA_OK) {
-						std::cerr << lua_tostring(L, -1) << '\n';
-						__debugbreak();
-					}
-		
+				char const* const modes[] = { "Sliced", "Worker thread" };
+				char const* const budgets[] = { "Time", "Instructions" };
+
+				ImGui::BeginDisabled(kScript.running());
+				ImGui::SetNextItemWidth(ImGui::GetFontSize() * 10.0f);
+				ImGui::Combo("Mode", &mode, modes, IM_ARRAYSIZE(modes));
+				ImGui::EndDisabled();
+				if (ImGui::IsItemHovered()) ImGui::SetTooltip("Sliced runs a part of the script every frame, the worker thread runs it to completion without waiting for frames");
+
+				if (mode == 0) {
+					ImGui::SameLine();
+					ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8.0f);
+					ImGui::Combo("Budget", &budget, budgets, IM_ARRAYSIZE(budgets));
+					ImGui::SameLine();
+					ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8.0f);
+					if (budget == 0)
+						ImGui::SliderFloat("Per frame", &budgetMs, 0.1f, 100.0f, "%.1f ms", ImGuiSliderFlags_Logarithmic);
+					else
+						ImGui::InputInt("Per frame", &budgetInstructions, 1000, 100000);
+					budgetInstructions = std::max(budgetInstructions, 1);
 				}
-		
-				if (L != nullptr) {
-		
-					static int ct = 0;
-					ct++;
-		
-					if (ct == 1) {
-						ct -= 1;
-		
-		
-						int status;
-		
-						//do
-						//{
-						int nres; // Number of return values, should be 0 when using inside hooks
-						status = lua_resume(T, 0, 0, &nres); // Start/resume thread
-						// The thread may be yielded, completed or have an error, but you get full control back in c, after every line of lua execution
-		
-						// Done!
-						if (status != LUA_YIELD) {
-							lua_close(L);
-							T = nullptr;
-							L = nullptr;
-						}
-		
-					//} while (status == LUA_YIELD);
-		
+
+				if (!kScript.running()) {
+					if (ImGui::Button("Run")) {
+						auto scriptMode = mode == 0 ? aurora::ScriptRunner::Mode::kSliced : aurora::ScriptRunner::Mode::kWorker;
+						if (!kScript.start(editor.GetText(), scriptMode, openAuroraLib))
+							std::cerr << kScript.error() << '\n';
+						markedLine = -1;
 					}
-		
 				}
-		
+				else if (ImGui::Button("Stop")) {
+					kScript.stop();
+				}
+
+				char const* const states[] = { "Idle", "Running", "Finished", "Failed", "Stopped" };
+				ImGui::SameLine();
+				ImGui::Text("%s, ~%llu instructions in %.3f s", states[static_cast<int>(kScript.state())], static_cast<unsigned long long>(kScript.instructions()), kScript.seconds());
+
+				int line = 0;
+				if (kScript.state() == aurora::ScriptRunner::State::kRunning) line = kScript.line();
+				else if (kScript.state() == aurora::ScriptRunner::State::kFailed) line = kScript.error_line();
+
+				if (line != markedLine || kScript.state() != markedState) {
+					TextEditor::ErrorMarkers markers;
+					if (line > 0) markers.insert(std::make_pair(line, kScript.state() == aurora::ScriptRunner::State::kFailed ? kScript.error() : std::string("Current line")));
+					editor.SetErrorMarkers(markers);
+
+					markedLine = line;
+					markedState = kScript.state();
+				}
+
 				editor.Render("Script");
 			}
 			
 			ImGui::End();
 		}
 
-		static char* objlibOrigin = nullptr;
-		static char* parseOffset = nullptr;
+		static char const* objlibOrigin = nullptr;
+		static size_t objlibSize = 0;
+		static char const* parseOffset = nullptr;
 		
 		const char* items[] = { "NOP", "Leaf", "Master", "Spn", "Samp"};
 		static int parseModeIdx = 0;
 
+		// Points the parser windows at the record at `offset` of the selected objlib
+		auto openDefinition = [&](size_t offset, size_t highlight) {
+			memedit.GotoAddrAndHighlight(offset, offset + highlight);
+			objlibOrigin = selection->raw.data();
+			objlibSize = selection->raw.size();
+			parseOffset = objlibOrigin + offset;
+
+			aurora::BinaryCursor cursor(selection->raw.bytes(), offset);
+
+			if (parseModeIdx == 1) {
+				leafParsed = ParsedLeaf();
+
+				try {
+					leafParsed->leaf.deserialize(cursor);
+				}
+				catch (aurora::TruncatedData const&) {
+					leafParsed->error = "Record runs past the end of the file";
+				}
+				catch (aurora::UnknownTraitType const& e) {
+					leafParsed->error = e.what();
+				}
+
+				leafParsed->curves = aurora::LeafCurves(leafParsed->leaf);
+			}
+
+			try {
+				if (parseModeIdx == 4) {
+					sampParsed = Samp();
+					sampParsed->deserialize(cursor);
+					sampParsed->origin(selection->originFile, offset, cursor.offset() - offset);
+				}
+				else if (parseModeIdx == 3) {
+					spnParsed = Spn();
+					spnParsed->deserialize(cursor);
+					spnParsed->origin(selection->originFile, offset, cursor.offset() - offset);
+				}
+			}
+			catch (aurora::TruncatedData const&) {
+				sampParsed = std::nullopt;
+				spnParsed = std::nullopt;
+				tinyfd_messageBox("Parse failed", "Record runs past the end of the file", "ok", "error", 1);
+			}
+		};
+
 		{
-			if (ImGui::Begin("Search for offset by bytes") && selection) {
+			if (ImGui::Begin("Search for offset by bytes")) {
 				static std::string input;
-				static int offsetbegin = 0;
+				static std::vector<aurora::CacheSearch::Hit> hits;
+				static size_t selectedHit = SIZE_MAX;
+
+				static bool sorted = true;
+
+				// Known record headers, in parse mode order, searching for all of them at once is a census of the whole cache
+				static constexpr std::pair<char const*, char const*> kHeaders[] = {
+					{ "Leaf header", "22 00 00 00 21 00 00 00 04 00 00 00 02 00 00 00" },
+					{ "Master header", "21 00 00 00 21 00 00 00 04 00 00 00 02 00 00 00" },
+					{ "Spn header", "01 00 00 00 04 00 00 00 02 00 00 00" },
+					{ "Samp header", "0C 00 00 00 04 00 00 00 01 00 00 00" },
+				};
+
+				for (auto const& [label, pattern] : kHeaders) {
+					if (ImGui::SmallButton(label)) {
+						if (!input.empty() && input.back() != '\n') input += '\n';
+						input += pattern;
+					}
+					ImGui::SameLine();
+				}
 
-				if (ImGui::SmallButton("Samp header")) { input = "0C 00 00 00 04 00 00 00 01 00 00 00"; parseModeIdx = 4; };
-				if (ImGui::SmallButton("Spn header")) { input = "01 00 00 00 04 00 00 00 02 00 00 00"; parseModeIdx = 3; };
-				if (ImGui::SmallButton("Master header")) { input = "21 00 00 00 21 00 00 00 04 00 00 00 02 00 00 00"; parseModeIdx = 2; };
-				if (ImGui::SmallButton("Leaf header")) { input = "22 00 00 00 21 00 00 00 04 00 00 00 02 00 00 00"; parseModeIdx = 1; }
+				if (ImGui::SmallButton("Clear")) input.clear();
 
-				ImGui::InputInt("Offset start", &offsetbegin);
-				ImGui::InputText("Byte search", &input);
+				ImGui::InputTextMultiline("Byte patterns", &input, ImVec2(0, ImGui::GetTextLineHeight() * 5));
 		
 				const char* combo_preview_value = items[parseModeIdx];
 				if (ImGui::BeginCombo("Parse mode", combo_preview_value, 0)) {
@@ -1324,189 +1867,467 @@ int main(int argc, char* argv[]) {
 					}
 					ImGui::EndCombo();
 				}
-		
 
-				if (ImGui::Button("Search")) { 
-					std::vector<std::string> tokens;
-					std::vector<uint8_t> byteTokens;
-					split(input, tokens, ' ');
-					byteTokens.reserve(tokens.size());
-
-					for (auto const& token : tokens) {
-						std::istringstream ss(token);
-						unsigned int byte;
-						ss >> std::hex >> byte;
-						byteTokens.push_back(static_cast<uint8_t>(byte));
-					}
+				if (kSearch.running()) {
+					if (ImGui::Button("Cancel")) kSearch.cancel();
+				}
+				else if (ImGui::Button("Search")) {
+					// One hex pattern per line
+					std::vector<std::vector<std::byte>> patterns;
+					std::string invalid;
 
-					auto occurance = std::search(selection->raw.data() + offsetbegin, selection->raw.data() + selection->raw.size(), byteTokens.data(), byteTokens.data() + byteTokens.size());
+					for (size_t begin = 0; begin <= input.size();) {
+						size_t end = std::min(input.find('\n', begin), input.size());
+						std::string_view line = std::string_view(input).substr(begin, end - begin);
+						begin = end + 1;
 
-					if (occurance == selection->raw.data() + selection->raw.size()) {
-						tinyfd_messageBox("Search failed", "Failed to find matching bytes", "ok", "error", 1);
+						if (line.find_first_not_of(" \t\r") == std::string_view::npos) continue;
 
+						if (auto pattern = aurora::parse_hex_pattern(line)) patterns.push_back(std::move(pattern.value()));
+						else invalid += "\n" + std::string(line);
+					}
+
+					if (!invalid.empty()) {
+						std::string message = "These lines aren't space separated hex bytes:" + invalid;
+						tinyfd_messageBox("Search failed", message.c_str(), "ok", "error", 1);
+					}
+					else if (patterns.empty()) {
+						tinyfd_messageBox("Search failed", "Enter at least one byte pattern", "ok", "error", 1);
 					}
 					else {
-						offsetbegin = occurance - selection->raw.data();
-						memedit.GotoAddrAndHighlight(occurance - selection->raw.data(), occurance - selection->raw.data() + 16);
-						objlibOrigin = selection->raw.data();
-						parseOffset = occurance;
-
-						if (parseModeIdx == 4) {
-							sampParsed = Samp();
-							char* a = parseOffset;
-							char* b = sampParsed->deserialize(parseOffset);
-							sampParsed->origin(selection->originFile, a - selection->raw.data(), b - a - 1);
-						}
-						else if (parseModeIdx == 3) {
-							spnParsed = Spn();
-							char* a = parseOffset;
-							char* b = spnParsed->deserialize(parseOffset);
-							spnParsed->origin(selection->originFile, a - selection->raw.data(), b - a - 1);
+						std::vector<std::filesystem::path> files;
+						files.reserve(kMap.size());
+						for (auto const& [k, v] : kMap)
+							files.push_back(v.originFile);
+
+						hits.clear();
+						selectedHit = SIZE_MAX;
+						sorted = false;
+						kSearch.start(std::move(files), aurora::PatternSet(std::move(patterns)));
+					}
+				}
+
+				// Hits stream in while the scan runs and are put in order once it's done
+				bool const finished = !kSearch.running();
+				kSearch.collect(hits);
+
+				if (finished && !sorted) {
+					sorted = true;
+					std::sort(hits.begin(), hits.end(), [](aurora::CacheSearch::Hit const& a, aurora::CacheSearch::Hit const& b) {
+						return std::tie(a.file, a.offset, a.pattern) < std::tie(b.file, b.offset, b.pattern);
+					});
+				}
+
+				double const seconds = kSearch.seconds();
+				double const mebibytes = static_cast<double>(kSearch.bytes_done()) / (1024.0 * 1024.0);
+				ImGui::SameLine();
+				ImGui::Text("%zu / %zu files, %zu hits, %.0f ms, %.0f MiB/s", kSearch.files_done(), kSearch.files().size(), hits.size(), seconds * 1000.0, seconds > 0.0 ? mebibytes / seconds : 0.0);
+
+				if (ImGui::BeginTable("Hits", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable)) {
+					ImGui::TableSetupScrollFreeze(0, 1);
+					ImGui::TableSetupColumn("File");
+					ImGui::TableSetupColumn("Offset");
+					ImGui::TableSetupColumn("Pattern");
+					ImGui::TableHeadersRow();
+
+					ImGuiListClipper clipper;
+					clipper.Begin(static_cast<int>(hits.size()));
+
+					while (clipper.Step()) {
+						for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+							aurora::CacheSearch::Hit const& hit = hits[row];
+							std::filesystem::path const& file = kSearch.files()[hit.file];
+
+							ImGui::TableNextRow();
+							ImGui::TableNextColumn();
+							ImGui::PushID(row);
+
+							std::string name = file.filename().string();
+							if (ImGui::Selectable(name.c_str(), selectedHit == static_cast<size_t>(row), ImGuiSelectableFlags_SpanAllColumns)) {
+								selectedHit = row;
+
+								auto it = kMap.find(file.stem().string());
+								if (it == kMap.end() || it->second.raw.size() == 0) {
+									tinyfd_messageBox("Open failed", "That objlib is no longer loaded", "ok", "error", 1);
+								}
+								else {
+									selection = &it->second;
+
+									// Headers the parser knows pick their own parse mode
+									std::span<std::byte const> pattern = kSearch.patterns().patterns()[hit.pattern];
+									for (int i = 0; i < IM_ARRAYSIZE(kHeaders); ++i)
+										if (std::ranges::equal(pattern, aurora::parse_hex_pattern(kHeaders[i].second).value())) parseModeIdx = i + 1;
+
+									openDefinition(hit.offset, pattern.size());
+								}
+							}
+
+							ImGui::PopID();
+							ImGui::TableNextColumn();
+							ImGui::Text("0x%llx", static_cast<unsigned long long>(hit.offset));
+							ImGui::TableNextColumn();
+							ImGui::Text("%u", hit.pattern + 1);
 						}
 					}
+
+					ImGui::EndTable();
 				}
 			}
 			ImGui::End();
 
+			if (viewUsages) {
+				if (ImGui::Begin("Find Usages", &viewUsages)) {
+					ImGui::InputText("Name or 0x hash", &usageQuery);
+
+					uint32_t hash = aurora::hash32(usageQuery);
+					if (usageQuery.starts_with("0x")) {
+						auto [ptr, error] = std::from_chars(usageQuery.data() + 2, usageQuery.data() + usageQuery.size(), hash, 16);
+						if (error != std::errc() || ptr != usageQuery.data() + usageQuery.size()) hash = aurora::hash32(usageQuery);
+					}
+
+					char const* name = kHashes.find(hash);
+					std::vector<aurora::UsageIndex::Usage> usages = kUsages.find(hash);
+
+					ImGui::Text("%08X %s, %zu usages", hash, name ? name : "", usages.size());
+					ImGui::TextDisabled("%zu object names indexed, %zu usages in %zu KiB", kUsages.key_count(), kUsages.usage_count(), kUsages.posting_bytes() / 1024);
+					if (kUsageBuilder.running())
+						ImGui::TextDisabled("Indexing, %zu / %zu files", kUsageBuilder.files_done(), kUsageBuilder.files().size());
+
+					if (ImGui::BeginTable("Usages", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+						ImGui::TableSetupScrollFreeze(0, 1);
+						ImGui::TableSetupColumn("File");
+						ImGui::TableSetupColumn("Offset");
+						ImGui::TableHeadersRow();
+
+						ImGuiListClipper clipper;
+						clipper.Begin(static_cast<int>(usages.size()));
+
+						while (clipper.Step()) {
+							for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+								aurora::UsageIndex::Usage const& usage = usages[row];
+								std::filesystem::path file = kUsageFiles[usage.file];
+
+								ImGui::TableNextRow();
+								ImGui::TableNextColumn();
+								ImGui::PushID(row);
+
+								std::string label = file.filename().string();
+								if (ImGui::Selectable(label.c_str(), false, ImGuiSelectableFlags_SpanAllColumns)) {
+									auto it = kMap.find(file.stem().string());
+									if (it != kMap.end()) {
+										selection = &it->second;
+										parseModeIdx = 0; // A usage sits inside some record, not at its start
+										openDefinition(usage.offset, sizeof(uint32_t));
+									}
+								}
+
+								ImGui::PopID();
+								ImGui::TableNextColumn();
+								ImGui::Text("0x%x", usage.offset);
+							}
+						}
+
+						ImGui::EndTable();
+					}
+				}
+				ImGui::End();
+			}
+
 			if (ImGui::Begin("Memory Viewer") && selection) {
-				memedit.DrawContents(selection->raw.data(), selection->raw.size(), (size_t)0);
+				memedit.DrawContents(const_cast<char*>(selection->raw.data()), selection->raw.size(), (size_t)0);
 			}
 			ImGui::End();
 
-		}
+			if (viewEdits) {
+				if (ImGui::Begin("Pending Edits", &viewEdits)) {
+					ImGui::Text("%zu edits queued", kEdits.edits().size());
 
-		if (parseOffset && parseModeIdx != 0) {
-			if (parseModeIdx == 1) {
-				if (ImGui::Begin("Parser")) {
+					ImGui::BeginDisabled(kEdits.empty());
 
-					struct DataPoint {
-						float datapoint;
-						std::any value;
-						std::string interpolation;
-						std::string easing;
-					};
+					if (ImGui::Button("Apply all")) {
+						// A running search, harvest or usage index build holds its own mappings of the files
+						// The harvest starts over once they're reloaded, the usage index is rebuilt after any reload anyway
+						bool const harvesting = kHarvest.running();
+						kSearch.cancel();
+						kHarvest.cancel();
+						if (kUsageBuilder.running()) kUsagesStale = true;
+						kUsageBuilder.cancel();
 
-					struct Trait {
-						std::string name;
-						uint32_t unknown0;
-						uint32_t param;
-						uint32_t subobjectIdentifier;
-						TraitType traitType;
-						std::vector<DataPoint> datapoints;
-					};
+						std::vector<std::string> files = kEdits.files();
 
-					struct Leaf {
-						uint32_t header[4];
-						uint32_t hash0;
-						uint32_t unknown0;
-						float unknown1;
-						std::string timeUnit;
-						uint32_t hash1;
-						std::vector<Trait> traits;
-					};
+						// Every apply adds a version, any earlier state of a file stays restorable
+						std::vector<std::string> unsaved;
+						for (std::string const& file : files)
+							if (!kBackups.snapshot(file))
+								unsaved.push_back(file);
 
-					char* iterator = parseOffset;
-					iterator += 16; // Skip header
+						if (!unsaved.empty()) {
+							std::string message = "Couldn't back up these files, nothing was applied:";
+							for (std::string const& file : unsaved)
+								message += "\n" + file;
 
-					ImGui::LabelText("Offset", "%p", (void*)(uintptr_t)(parseOffset - objlibOrigin));
-					ImGui::Separator();
+							tinyfd_messageBox("Apply failed", message.c_str(), "ok", "error", 1);
+							files.clear();
+						}
 
-					displayHash("Hash", readUint32(&iterator));
-					ImGui::LabelText("Unknown", "%08X", readUint32(&iterator));
-					ImGui::LabelText("Unknown", "%f", std::bit_cast<float>(readUint32(&iterator)));
-					ImGui::LabelText("Timeunit", "%s", readString(&iterator).c_str());
-					displayHash("Hash", readUint32(&iterator));
-					uint32_t numTraits = readUint32(&iterator);
+						// Windows can't replace mapped files, every touched objlib is mapped again afterwards
+						for (auto& [k, v] : kMap)
+							if (std::binary_search(files.begin(), files.end(), v.originFile))
+								v.raw = {};
 
+						aurora::EditQueue::Result result = files.empty() ? aurora::EditQueue::Result{} : kEdits.apply();
 
-					ImGui::LabelText("Num traits", "%d", numTraits);
+						for (std::string const& file : files)
+							reloadObjlib(file);
 
-					for (uint32_t i = 0; i < numTraits; ++i) {
+						if (harvesting) startHarvest();
 
-						ImGui::PushID(i);
+						// Every parsed view below pointed into a mapping that was just replaced
+						objlibOrigin = nullptr;
+						objlibSize = 0;
+						parseOffset = nullptr;
+						sampParsed = std::nullopt;
+						spnParsed = std::nullopt;
+						leafParsed = std::nullopt;
 
-						std::string traitName = readString(&iterator);
+						if (!result.failed.empty()) {
+							std::string message = "These files were left unchanged, their edits are still queued:";
+							for (std::string const& file : result.failed)
+								message += "\n" + file;
 
-						ImGui::LabelText("Trait name", "%s", traitName.c_str());
-						ImGui::LabelText("Unknown", "%08X", readUint32(&iterator));
+							tinyfd_messageBox("Apply failed", message.c_str(), "ok", "error", 1);
+						}
+					}
 
-						displayHash("Parameter", readUint32(&iterator));
+					ImGui::SameLine();
+
+					if (ImGui::Button("Discard all"))
+						kEdits.clear();
+
+					ImGui::EndDisabled();
+
+					if (ImGui::BeginTable("Edits", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingStretchProp)) {
+						ImGui::TableSetupColumn("Record");
+						ImGui::TableSetupColumn("File");
+						ImGui::TableSetupColumn("Offset");
+						ImGui::TableSetupColumn("Size");
+						ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed);
+						ImGui::TableHeadersRow();
+
+						std::optional<size_t> removed;
+						auto edits = kEdits.edits();
+
+						for (size_t i = 0; i < edits.size(); ++i) {
+							auto const& edit = edits[i];
+							std::string fileName = std::filesystem::path(edit.file).filename().string();
+
+							ImGui::PushID(static_cast<int>(i));
+							ImGui::TableNextRow();
+							ImGui::TableNextColumn();
+							ImGui::TextUnformatted(edit.label.c_str());
+							ImGui::TableNextColumn();
+							ImGui::TextUnformatted(fileName.c_str());
+							ImGui::TableNextColumn();
+							ImGui::Text("0x%zX", edit.offset);
+							ImGui::TableNextColumn();
+							ImGui::Text("%zu -> %zu", edit.size, edit.data.size());
+							ImGui::TableNextColumn();
+							if (ImGui::SmallButton("Remove")) removed = i;
+							ImGui::PopID();
+						}
 
-						ImGui::LabelText("Subobject Identifier", "%08X", readUint32(&iterator));
-						TraitType traitType = (TraitType)readUint32(&iterator);
-						ImGui::LabelText("Trait type", "%d", (uint32_t)traitType);
-						uint32_t numDatapoints = readUint32(&iterator);
-						ImGui::LabelText("Num datapoints", "%d", numDatapoints);
+						ImGui::EndTable();
 
-						for (uint32_t j = 0; j < numDatapoints; ++j) {
-							uint32_t datapoint = readUint32(&iterator);
+						if (removed) kEdits.erase(*removed);
+					}
+				}
+				ImGui::End();
+			}
 
-							std::any value;
-							if (traitType == TraitType::kTraitFloat) value = std::bit_cast<float>(readUint32(&iterator));
-							else if (traitType == TraitType::kTraitAction) value = std::bit_cast<char>(readByte(&iterator));
-							else if (traitType == TraitType::kTraitBool) value = std::bit_cast<char>(readByte(&iterator));
-							else __debugbreak();
+			if (viewBackups) {
+				if (ImGui::Begin("Backups", &viewBackups)) {
+					struct BackupFile {
+						std::string name;
+						std::vector<aurora::BackupStore::Version> versions;
+					};
 
-							std::string interpolation = readString(&iterator);
-							std::string easingMode = readString(&iterator);
+					static std::vector<BackupFile> backupFiles;
+					static bool backupsStale = true;
 
-							std::string str = std::format("[{}]", j);
+					if (ImGui::Button("Refresh")) backupsStale = true;
 
-							if (ImGui::TreeNode(str.c_str())) {
-								ImGui::LabelText("Time", "%f", std::bit_cast<float>(datapoint));
+					if (backupsStale) {
+						backupFiles.clear();
+						for (std::string& name : kBackups.files()) {
+							auto versions = kBackups.versions(name);
+							backupFiles.push_back({ std::move(name), std::move(versions) });
+						}
+						backupsStale = false;
+					}
 
-								if (traitType == TraitType::kTraitFloat) ImGui::LabelText("Value", "%f", std::any_cast<float>(value));
-								else if (traitType == TraitType::kTraitAction) ImGui::LabelText("Value", "%d", std::any_cast<char>(value));
-								else if (traitType == TraitType::kTraitBool) ImGui::LabelText("Value", "%d", std::any_cast<char>(value));
-								else __debugbreak();
+					for (BackupFile const& file : backupFiles) {
+						if (!ImGui::TreeNode(file.name.c_str())) continue;
 
-								ImGui::LabelText("Interpolation", "%s", interpolation.c_str());
-								ImGui::LabelText("Easing", "%s", easingMode.c_str());
+						for (auto const& version : file.versions) {
+							ImGui::PushID(static_cast<int>(version.number));
+							if (ImGui::SmallButton("Restore")) {
+								std::string path = kCacheDir + "/" + file.name;
 
-								ImGui::TreePop();
-							}
+								// Windows can't replace mapped files
+								auto it = kMap.find(std::filesystem::path(file.name).stem().string());
+								if (it != kMap.end()) it->second.raw = {};
 
+								if (!kBackups.restore(path, version.number))
+									tinyfd_messageBox("Restore failed", "The backup is incomplete or the file couldn't be written", "ok", "error", 1);
+
+								if (it != kMap.end()) {
+									reloadObjlib(path);
+									objlibOrigin = nullptr;
+									objlibSize = 0;
+									parseOffset = nullptr;
+									sampParsed = std::nullopt;
+									spnParsed = std::nullopt;
+									leafParsed = std::nullopt;
+								}
+
+								backupsStale = true;
+							}
+							ImGui::SameLine();
+							ImGui::TextUnformatted(versionLabel(version).c_str());
+							ImGui::PopID();
 						}
 
-						ImGui::Separator();
-						ImGui::TextUnformatted("Total number of displayed UI elements for data points on Drool's Editor.");
-						uint32_t additional_unknown = readUint32(&iterator);
-						for (uint32_t j = 0; j < additional_unknown; ++j) {
-							ImGui::LabelText("Time", "%f", std::bit_cast<float>(readUint32(&iterator)));
+						ImGui::TreePop();
+					}
+				}
+				ImGui::End();
+			}
 
-							char const* label = (j == additional_unknown - 1) ? "Value (unused)" : "Value";
-							ImGui::LabelText(label, "%f", std::bit_cast<float>(readUint32(&iterator)));
+		}
 
+		if (parseOffset && parseModeIdx != 0) {
+			if (parseModeIdx == 1) {
+				if (ImGui::Begin("Parser") && leafParsed) {
+					aurora::Leaf const& leaf = leafParsed->leaf;
 
+					ImGui::LabelText("Offset", "%p", (void*)(uintptr_t)(parseOffset - objlibOrigin));
+					ImGui::Separator();
 
-							ImGui::LabelText("Interpolation", readString(&iterator).c_str());
-							ImGui::LabelText("Easing", readString(&iterator).c_str());
-						}
-						ImGui::Separator();
+					displayHash("Hash", leaf.hash0);
+					ImGui::LabelText("Unknown", "%08X", leaf.unknown0);
+					ImGui::LabelText("Unknown", "%f", leaf.unknown1);
+					ImGui::LabelText("Timeunit", "%s", leaf.timeUnit.c_str());
+					displayHash("Hash", leaf.hash1);
+					ImGui::LabelText("Num traits", "%d", leaf.traitCount);
+
+					for (size_t i = 0; i < leaf.traits.size(); ++i) {
+						aurora::Leaf::Trait const& trait = leaf.traits[i];
+						ImGui::PushID(static_cast<int>(i));
+
+						ImGui::LabelText("Trait name", "%s", trait.name.c_str());
+						ImGui::LabelText("Unknown", "%08X", trait.unknown0);
+						displayHash("Parameter", trait.param);
+						ImGui::LabelText("Subobject Identifier", "%08X", trait.subobjectIdentifier);
+						aurora::TraitCodec const& codec = aurora::trait_codec(trait.traitType);
+						ImGui::LabelText("Trait type", "%s (%d)", codec.name, (uint32_t)trait.traitType);
+						ImGui::LabelText("Num datapoints", "%d", static_cast<int>(trait.datapoint_count()));
+
+						// Thousands of points cost nothing while collapsed, and only the visible rows when open
+						auto pointTable = [](char const* label, size_t count, auto&& row) {
+							if (count == 0 || !ImGui::TreeNode(label)) return;
+
+							if (ImGui::BeginTable("Points", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+								ImGui::TableSetupColumn("Time");
+								ImGui::TableSetupColumn("Value");
+								ImGui::TableSetupColumn("Interpolation");
+								ImGui::TableSetupColumn("Easing");
+								ImGui::TableHeadersRow();
+
+								ImGuiListClipper clipper;
+								clipper.Begin(static_cast<int>(count));
+								while (clipper.Step()) {
+									for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+										ImGui::TableNextRow();
+										row(static_cast<size_t>(i));
+									}
+								}
+
+								ImGui::EndTable();
+							}
 
+							ImGui::TreePop();
+						};
+
+						pointTable("Datapoints", trait.datapoint_count(), [&](size_t j) {
+							ImGui::TableNextColumn();
+							ImGui::Text("%f", trait.times[j]);
+							ImGui::TableNextColumn();
+							for (size_t c = 0; c < codec.components; ++c) {
+								if (c != 0) ImGui::SameLine();
+
+								size_t k = j * codec.components + c;
+								switch (codec.column) {
+								case aurora::TraitColumn::kFloats: ImGui::Text("%f", trait.floats[k]); break;
+								case aurora::TraitColumn::kInts: ImGui::Text("%d", trait.ints[k]); break;
+								case aurora::TraitColumn::kBytes: ImGui::Text("%d", trait.bytes[k]); break;
+								default: break;
+								}
+							}
+							ImGui::TableNextColumn();
+							ImGui::TextUnformatted(leaf.symbols[trait.interpolations[j]].c_str());
+							ImGui::TableNextColumn();
+							ImGui::TextUnformatted(leaf.symbols[trait.easings[j]].c_str());
+						});
+
+						// Total number of displayed UI elements for data points on Drool's Editor, the last value is unused
+						pointTable("Editor points", trait.editorPoints.size(), [&](size_t j) {
+							auto const& point = trait.editorPoints[j];
+							ImGui::TableNextColumn();
+							ImGui::Text("%f", point.time);
+							ImGui::TableNextColumn();
+							ImGui::Text("%f", point.value);
+							ImGui::TableNextColumn();
+							ImGui::TextUnformatted(point.interpolation.c_str());
+							ImGui::TableNextColumn();
+							ImGui::TextUnformatted(point.easing.c_str());
+						});
+
+						// Sampled only while open, across the datapoints
+						if (leafParsed->curves.point_count(i) > 1 && ImGui::TreeNode("Curve")) {
+							constexpr size_t kSamples = 512;
+							float const begin = leafParsed->curves.begin_time(i);
+							float const end = leafParsed->curves.end_time(i);
+
+							std::array<float, kSamples> times;
+							std::array<float, kSamples> values;
+							for (size_t j = 0; j < kSamples; ++j)
+								times[j] = begin + (end - begin) * static_cast<float>(j) / (kSamples - 1);
+							leafParsed->curves.sample(i, times, values);
+
+							ImGui::PlotLines("##curve", values.data(), static_cast<int>(kSamples), 0, nullptr, FLT_MAX, FLT_MAX, ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 6));
+							ImGui::Text("%f to %f", begin, end);
+							ImGui::TreePop();
+						}
 
-						ImGui::LabelText("Unknown", "%d", readUint32(&iterator));
-						ImGui::LabelText("Unknown", "%d", readUint32(&iterator));
-						ImGui::LabelText("Unknown", "%d", readUint32(&iterator));
-						ImGui::LabelText("Unknown", "%d", readUint32(&iterator));
-						ImGui::LabelText("Unknown", "%d", readUint32(&iterator));
-						ImGui::LabelText("Intensity type (A)", "%s", readString(&iterator).c_str());
-						ImGui::LabelText("Intensity type (B)", "%s", readString(&iterator).c_str());
-						ImGui::LabelText("Unknown", "%d", readByte(&iterator));
-						ImGui::LabelText("Unknown", "%d", readByte(&iterator));
-						ImGui::LabelText("Unknown", "%d", readUint32(&iterator));
-						ImGui::LabelText("Unknown", "%f", std::bit_cast<float>(readUint32(&iterator)));
-						ImGui::LabelText("Unknown", "%f", std::bit_cast<float>(readUint32(&iterator)));
-						ImGui::LabelText("Unknown", "%f", std::bit_cast<float>(readUint32(&iterator)));
-						ImGui::LabelText("Unknown", "%f", std::bit_cast<float>(readUint32(&iterator)));
-						ImGui::LabelText("Unknown", "%f", std::bit_cast<float>(readUint32(&iterator)));
-						ImGui::LabelText("Unknown", "%d", readByte(&iterator));
-						ImGui::LabelText("Unknown", "%d", readByte(&iterator));
-						ImGui::LabelText("Unknown", "%d", readByte(&iterator));
+						for (uint32_t value : trait.unknown1)
+							ImGui::LabelText("Unknown", "%d", value);
+						ImGui::LabelText("Intensity type (A)", "%s", trait.intensityA.c_str());
+						ImGui::LabelText("Intensity type (B)", "%s", trait.intensityB.c_str());
+						for (uint8_t value : trait.unknown2)
+							ImGui::LabelText("Unknown", "%d", value);
+						ImGui::LabelText("Unknown", "%d", trait.unknown3);
+						for (float value : trait.unknown4)
+							ImGui::LabelText("Unknown", "%f", value);
+						for (uint8_t value : trait.unknown5)
+							ImGui::LabelText("Unknown", "%d", value);
 
+						ImGui::Separator();
 						ImGui::PopID();
 					}
 
+					if (!leafParsed->error.empty())
+						ImGui::TextUnformatted(leafParsed->error.c_str());
+
 					// We need to figure out how many 0 bytes pad the end of the leaf
 				}
 				ImGui::End();
@@ -1515,38 +2336,42 @@ int main(int argc, char* argv[]) {
 
 			if (parseModeIdx == 2) {
 				if (ImGui::Begin("Master dump")) {
-					char* iterator = parseOffset;
-					iterator += 16; // Skip header
-
-					ImGui::LabelText("Offset", "%p", (void*)(uintptr_t)(parseOffset - objlibOrigin));
-					ImGui::Separator();
-
-					displayHash("Hash", readUint32(&iterator));
-					ImGui::LabelText("Unknown", "%d", readUint32(&iterator));
-					displayHash("Hash", readUint32(&iterator));
-					ImGui::LabelText("Timeunit", "%s", readString(&iterator).c_str());
-					displayHash("Hash", readUint32(&iterator));
-					ImGui::LabelText("Unknown", "%d", readUint32(&iterator));
-					ImGui::LabelText("Unknown", "%f", std::bit_cast<float>(readUint32(&iterator)));
-					ImGui::LabelText("Skybox name", "%s", readString(&iterator).c_str());
-					ImGui::LabelText("Intro level", "%s", readString(&iterator).c_str());
-
-					uint32_t numSublevels = readUint32(&iterator);
-					ImGui::LabelText("Num sublevels", "%d", numSublevels);
-
-					if(numSublevels >= 1) {
+					try {
+						aurora::BinaryCursor iterator(objlibOrigin, objlibOrigin + objlibSize, parseOffset - objlibOrigin);
+						iterator.skip(16); // Skip header
 
+						ImGui::LabelText("Offset", "%p", (void*)(uintptr_t)(parseOffset - objlibOrigin));
 						ImGui::Separator();
-						ImGui::LabelText("Level name", "%s", readString(&iterator).c_str()); // .lvl
-						ImGui::LabelText("Gate name", "%s", readString(&iterator).c_str());
-						ImGui::LabelText("Checkpoint?", "%d", readByte(&iterator));
-						ImGui::LabelText("Checkpoint leader level name", "%s", readString(&iterator).c_str());
-						ImGui::LabelText("Rest level name", "%s", readString(&iterator).c_str());
+
+						displayHash("Hash", iterator.read_u32());
+						ImGui::LabelText("Unknown", "%d", iterator.read_u32());
+						displayHash("Hash", iterator.read_u32());
+						ImGui::LabelText("Timeunit", "%s", iterator.read_string().c_str());
+						displayHash("Hash", iterator.read_u32());
+						ImGui::LabelText("Unknown", "%d", iterator.read_u32());
+						ImGui::LabelText("Unknown", "%f", iterator.read_f32());
+						ImGui::LabelText("Skybox name", "%s", iterator.read_string().c_str());
+						ImGui::LabelText("Intro level", "%s", iterator.read_string().c_str());
+
+						uint32_t numSublevels = iterator.read_u32();
+						ImGui::LabelText("Num sublevels", "%d", numSublevels);
+
+						if(numSublevels >= 1) {
+
+							ImGui::Separator();
+							ImGui::LabelText("Level name", "%s", iterator.read_string().c_str()); // .lvl
+							ImGui::LabelText("Gate name", "%s", iterator.read_string().c_str());
+							ImGui::LabelText("Checkpoint?", "%d", iterator.read<char>());
+							ImGui::LabelText("Checkpoint leader level name", "%s", iterator.read_string().c_str());
+							ImGui::LabelText("Rest level name", "%s", iterator.read_string().c_str());
 					
-						ImGui::TextUnformatted("A variable length buffer is here and is unknown how to calculate its length, cannot parse further");
+							ImGui::TextUnformatted("A variable length buffer is here and is unknown how to calculate its length, cannot parse further");
 
+						}
+					}
+					catch (aurora::TruncatedData const&) {
+						ImGui::TextUnformatted("Record runs past the end of the file");
 					}
-
 				}
 				ImGui::End();
 			}
@@ -1565,15 +2390,284 @@ int main(int argc, char* argv[]) {
 		if (viewHasher) {
 			if (ImGui::Begin("Hasher", &viewHasher)) {
 				static std::string input;
-				static uint32_t hash = hash32(nullptr, 0);
+				static uint32_t hash = aurora::hash32({});
 				if (ImGui::InputText("Input", &input))
-					hash = hash32((unsigned char const*)input.data(), static_cast<unsigned int>(input.size()));
+					hash = aurora::hash32(input);
 
 				ImGui::Text("0x%02X", hash);
+
+				char const* known = kHashes.find(hash);
+				ImGui::BeginDisabled(input.empty() || known);
+
+				if (ImGui::Button("Remember name"))
+					learnHashName(input);
+
+				ImGui::EndDisabled();
+				ImGui::Text("%zu names known", kHashes.size());
 			}
 			ImGui::End();
 		}
 
+		if (viewCracker) {
+			if (ImGui::Begin("Hash Cracker", &viewCracker)) {
+				// Patterns seen in names found so far
+				static std::string grammars =
+					"{words}.ent\n"
+					"{words}{a|z}{01-99}\n"
+					"{words}.{a|z}{01-99}\n"
+					"level_{1-99}\n"
+					"{words}_{words}";
+				static std::string extraTargets;
+				static std::vector<aurora::HashCracker::Hit> hits;
+
+				ImGui::TextUnformatted("One grammar per line: text, {a|b} alternatives, {0-99} or {00-99} numbers, {words} for every known name and its _ separated pieces");
+				ImGui::InputTextMultiline("Grammars", &grammars, ImVec2(0, ImGui::GetTextLineHeight() * 6));
+				ImGui::InputTextMultiline("Extra hashes", &extraTargets, ImVec2(0, ImGui::GetTextLineHeight() * 3));
+				ImGui::Text("%zu unresolved hashes seen so far", kUnresolved.size());
+
+				if (kCracker.running()) {
+					if (ImGui::Button("Cancel")) kCracker.cancel();
+				}
+				else if (ImGui::Button("Crack")) {
+					std::vector<std::string> words;
+					for (std::string_view name : kHashes.names()) {
+						words.emplace_back(name);
+
+						for (size_t begin = 0; begin < name.size();) {
+							size_t end = std::min(name.find_first_of("_.", begin), name.size());
+							if (end > begin) words.emplace_back(name.substr(begin, end - begin));
+							begin = end + 1;
+						}
+					}
+
+					std::sort(words.begin(), words.end());
+					words.erase(std::unique(words.begin(), words.end()), words.end());
+
+					std::vector<aurora::HashGrammar> parsed;
+					std::string invalid;
+					std::istringstream lines(grammars);
+					for (std::string line; std::getline(lines, line);) {
+						if (line.empty()) continue;
+						if (auto grammar = aurora::HashGrammar::parse(line, words)) parsed.push_back(std::move(grammar.value()));
+						else invalid += "\n" + line;
+					}
+
+					std::vector<uint32_t> targets(kUnresolved.begin(), kUnresolved.end());
+					std::istringstream extra(extraTargets);
+					for (std::string token; extra >> token;) {
+						uint32_t hash = 0;
+						auto [ptr, error] = std::from_chars(token.data() + (token.starts_with("0x") ? 2 : 0), token.data() + token.size(), hash, 16);
+						if (error == std::errc() && ptr == token.data() + token.size()) targets.push_back(hash);
+						else invalid += "\n" + token;
+					}
+
+					if (!invalid.empty()) {
+						std::string message = "Couldn't read these lines or they describe more than 2^48 candidates:" + invalid;
+						tinyfd_messageBox("Crack failed", message.c_str(), "ok", "error", 1);
+					}
+					else if (targets.empty()) {
+						tinyfd_messageBox("Crack failed", "No unresolved hashes yet, browse some objects or enter hashes", "ok", "error", 1);
+					}
+					else {
+						hits.clear();
+						kCracker.start(std::move(parsed), std::move(targets));
+					}
+				}
+
+				// Every hit is a name from now on, any field showing its hash picks it up right away
+				size_t const before = hits.size();
+				kCracker.collect(hits);
+				for (size_t i = before; i < hits.size(); ++i)
+					learnHashName(hits[i].name);
+
+				double const seconds = kCracker.seconds();
+				ImGui::SameLine();
+				ImGui::Text("%s, %llu / %llu candidates, %.0f M/s", aurora::simd_level_name(kCracker.level()), static_cast<unsigned long long>(kCracker.tested()), static_cast<unsigned long long>(kCracker.total()), seconds > 0.0 ? static_cast<double>(kCracker.tested()) / seconds / 1e6 : 0.0);
+
+				if (ImGui::BeginTable("Hits", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+					ImGui::TableSetupScrollFreeze(0, 1);
+					ImGui::TableSetupColumn("Hash");
+					ImGui::TableSetupColumn("Name");
+					ImGui::TableHeadersRow();
+
+					for (auto const& hit : hits) {
+						ImGui::TableNextRow();
+						ImGui::TableNextColumn();
+						ImGui::Text("%08X", hit.hash);
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(hit.name.c_str());
+					}
+
+					ImGui::EndTable();
+				}
+			}
+			ImGui::End();
+		}
+
+		if (viewHarvest) {
+			if (ImGui::Begin("String Harvest", &viewHarvest)) {
+				if (kHarvest.running()) {
+					ImGui::Text("Harvesting, %zu / %zu files", kHarvest.files_done(), kHarvest.files_total());
+				}
+				else if (ImGui::Button("Harvest again")) {
+					startHarvest();
+				}
+
+				if (kHarvestReport) {
+					aurora::StringHarvest::Result const& report = kHarvestReport.value();
+					ImGui::Text("%.1f MiB in %.0f ms, %llu strings, %zu new names", static_cast<double>(report.bytes) / (1024.0 * 1024.0), report.seconds * 1000.0, static_cast<unsigned long long>(report.found), kHarvestNewNames);
+					ImGui::Text("%zu hashes shown before the harvest are now explained", report.strings.size());
+
+					if (ImGui::BeginTable("Explained", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+						ImGui::TableSetupScrollFreeze(0, 1);
+						ImGui::TableSetupColumn("Hash");
+						ImGui::TableSetupColumn("Name");
+						ImGui::TableHeadersRow();
+
+						for (auto const& string : report.strings) {
+							ImGui::TableNextRow();
+							ImGui::TableNextColumn();
+							ImGui::Text("%08X", string.hash);
+							ImGui::TableNextColumn();
+							ImGui::TextUnformatted(string.text.c_str());
+						}
+
+						ImGui::EndTable();
+					}
+				}
+			}
+			ImGui::End();
+		}
+
+		if (viewDependencies) {
+			if (ImGui::Begin("Dependencies", &viewDependencies)) {
+				using Id = aurora::DependencyGraph::Id;
+
+				auto libraryName = [](Id library) { return kGraph.name(kGraph.libraries()[library].name); };
+				auto listLibraries = [&](std::span<Id const> libraries) {
+					for (Id library : libraries) {
+						std::string_view name = libraryName(library);
+						if (kGraph.libraries()[library].lib) ImGui::Text("%.*s", static_cast<int>(name.size()), name.data());
+						else ImGui::TextDisabled("%.*s (not loaded)", static_cast<int>(name.size()), name.data());
+					}
+				};
+
+				ImGui::Text("%zu libraries, %zu objects, %zu dangling imports", kGraph.libraries().size(), kGraph.objects().size(), kGraph.dangling().size());
+
+				Id library = selection ? kGraph.find_library(selection->originalName) : aurora::DependencyGraph::kNone;
+				if (library == aurora::DependencyGraph::kNone) {
+					ImGui::TextUnformatted("Select an objlib in Obj Libs");
+				}
+				else {
+					std::string_view name = libraryName(library);
+					ImGui::SeparatorText(std::string(name).c_str());
+
+					if (ImGui::TreeNode("Dependencies", "Imports from (%zu)", kGraph.dependencies(library).size())) {
+						listLibraries(kGraph.dependencies(library));
+						ImGui::TreePop();
+					}
+
+					if (ImGui::TreeNode("Dependents", "Imported by (%zu)", kGraph.dependents(library).size())) {
+						listLibraries(kGraph.dependents(library));
+						ImGui::TreePop();
+					}
+
+					if (ImGui::TreeNode("All dependents")) {
+						listLibraries(kGraph.transitive_dependents({ &library, 1 }));
+						ImGui::TreePop();
+					}
+
+					if (ImGui::TreeNode("All dependencies")) {
+						listLibraries(kGraph.transitive_dependencies(library));
+						ImGui::TreePop();
+					}
+
+					// Which libraries need checking after editing one of these objects
+					if (ImGui::TreeNode("Impact of editing an object")) {
+						for (Id object : kGraph.definitions(library)) {
+							std::string_view objectName = kGraph.name(kGraph.objects()[object].name);
+							std::vector<Id> affected = kGraph.impact(object);
+
+							ImGui::PushID(static_cast<int>(object));
+							if (ImGui::TreeNode("Object", "%.*s: %zu importers, %zu libraries affected", static_cast<int>(objectName.size()), objectName.data(), kGraph.importers(object).size(), affected.size())) {
+								listLibraries(affected);
+								ImGui::TreePop();
+							}
+							ImGui::PopID();
+						}
+
+						ImGui::TreePop();
+					}
+				}
+
+				if (ImGui::TreeNode("Dangling imports")) {
+					ImGuiListClipper clipper;
+					clipper.Begin(static_cast<int>(kGraph.dangling().size()));
+
+					while (clipper.Step()) {
+						for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+							aurora::DependencyGraph::Dangling const& dangling = kGraph.dangling()[row];
+							std::string_view importer = libraryName(dangling.importer);
+							std::string_view missing = kGraph.name(dangling.name);
+
+							if (dangling.library == aurora::DependencyGraph::kNone) {
+								ImGui::Text("%.*s: library %.*s", static_cast<int>(importer.size()), importer.data(), static_cast<int>(missing.size()), missing.data());
+							}
+							else {
+								std::string_view from = libraryName(dangling.library);
+								ImGui::Text("%.*s: %.*s from %.*s", static_cast<int>(importer.size()), importer.data(), static_cast<int>(missing.size()), missing.data(), static_cast<int>(from.size()), from.data());
+							}
+						}
+					}
+
+					ImGui::TreePop();
+				}
+			}
+			ImGui::End();
+		}
+
+		if (viewCensus) {
+			if (ImGui::Begin("Object Census", &viewCensus)) {
+				ImGui::TextUnformatted("Definitions are located for Samp, Spn, Master and Leaf objects");
+				ImGui::TextUnformatted("A length is only known when the next declared object was located too, bytes only count those");
+
+				if (ImGui::BeginTable("Census", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingStretchProp)) {
+					ImGui::TableSetupColumn("Type");
+					ImGui::TableSetupColumn("Declared");
+					ImGui::TableSetupColumn("Located");
+					ImGui::TableSetupColumn("Measured");
+					ImGui::TableSetupColumn("Bytes");
+					ImGui::TableHeadersRow();
+
+					for (CensusRow const& row : kCensus) {
+						char const* typeName = objTypeName(row.type);
+
+						ImGui::TableNextRow();
+						ImGui::TableNextColumn();
+						if (typeName) ImGui::TextUnformatted(typeName);
+						else ImGui::Text("%08X", static_cast<uint32_t>(row.type));
+						ImGui::TableNextColumn();
+						ImGui::Text("%zu", row.declared);
+						ImGui::TableNextColumn();
+						if (isIndexedObjType(row.type)) ImGui::Text("%zu", row.located);
+						ImGui::TableNextColumn();
+						if (isIndexedObjType(row.type)) ImGui::Text("%zu", row.measured);
+						ImGui::TableNextColumn();
+						if (isIndexedObjType(row.type)) ImGui::Text("%llu", static_cast<unsigned long long>(row.bytes));
+					}
+
+					ImGui::EndTable();
+				}
+			}
+			ImGui::End();
+		}
+
+		if (viewBenchmark) {
+			if (ImGui::Begin("Benchmark", &viewBenchmark))
+				ImGui::TextUnformatted(benchmarkReport.data(), benchmarkReport.data() + benchmarkReport.size());
+			ImGui::End();
+		}
+
 		if (viewBpms) {
 			if (ImGui::Begin("Level Bpms", &viewBpms)) {
 				ImGui::LabelText("Level 1", "%s", "320");
@@ -1604,68 +2698,125 @@ int main(int argc, char* argv[]) {
 
 		if (ImGui::Begin("Obj Libs")) {
 			ImGui::Text("Loaded %d libs", kMap.size());
-			ImGui::Text("Failed to load %d libs", failedCount);
+			ImGui::Text("Failed to load %d libs", failedCount.load());
+			ImGui::Text("Indexed %zu files: %zu objlibs, %zu meshes, %zu textures", kCacheIndex.entries.size(), kCacheIndex.count(FileType::kObjlib), kCacheIndex.count(FileType::kMeshX), kCacheIndex.count(FileType::kFsbTexture) + kCacheIndex.count(FileType::kDdsTexture));
 
 			ImGui::InputText("Filter", &filter);
+			kObjlibBrowser.update(filter);
+			ImGui::Text("Showing %zu of %zu libs", kObjlibBrowser.filter.results().size(), kObjlibBrowser.libs.size());
+
+			float const indent = ImGui::GetStyle().IndentSpacing;
+
+			// Every row is one text line high, the clipper only submits the ones in view
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(kObjlibBrowser.rows.size()));
+
+			while (clipper.Step()) {
+				for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+					ObjlibRow const& r = kObjlibBrowser.rows[row];
+					Objlib& v = *kObjlibBrowser.libs[r.lib].lib;
+					uint8_t const open = kObjlibBrowser.open[r.lib];
+
+					int depth = 0;
+					switch (r.kind) {
+					case ObjlibRow::kLibrary: depth = 0; break;
+					case ObjlibRow::kLibraryImport:
+					case ObjlibRow::kObjectImport:
+					case ObjlibRow::kObject: depth = 2; break;
+					default: depth = 1; break;
+					}
 
-			for (auto& [k, v] : kMap) {
-
-				bool matches = true;
+					if (depth > 0) ImGui::Indent(depth * indent);
+					ImGui::PushID(&v);
 
-				// Apply filters
-				if (!filter.empty()) {
-					std::vector<std::string> tokens;
-					split(filter, tokens, ' ');
+					// Child nodes have their open state driven from the browser, it decides which rows exist
+					auto node = [&](char const* label, ObjlibBrowser::OpenBits bit) {
+						ImGui::SetNextItemOpen(open & bit);
+						bool isOpen = ImGui::TreeNodeEx(label, ImGuiTreeNodeFlags_NoTreePushOnOpen);
+						kObjlibBrowser.set_open(r.lib, bit, isOpen);
+					};
 
+					switch (r.kind) {
+					case ObjlibRow::kLibrary: {
+						ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_NoTreePushOnOpen;
+						if (selection == &v) flags |= ImGuiTreeNodeFlags_Selected;
 
-					for (auto const& token : tokens)
-						if (!v.originalName.contains(token)) {
-							matches = false;
-							break;
+						ImGui::SetNextItemOpen(open & ObjlibBrowser::kOpenLibrary);
+						bool isOpen = ImGui::TreeNodeEx(&v, flags, "%.*s", static_cast<int>(v.originalName.size()), v.originalName.data());
+						if (ImGui::IsItemClicked()) {
+							selection = &v;
 						}
-				}
-
-				if (!matches) continue;
-
-				bool node_open = ImGui::TreeNodeEx(v.originalName.c_str(), selection == &v ? ImGuiTreeNodeFlags_Selected : ImGuiTreeNodeFlags_None);
-				if (ImGui::IsItemClicked()) {
-					selection = &v;
-				}
-
-				if (node_open) {
-					ImGui::LabelText("Origin", "%s", k.c_str());
-
-					ImGui::PushID(&v);
-					
-					if (ImGui::SmallButton("Jump to object definitions")) {
-						selection = &v;
-						memedit.GotoAddrAndHighlight(v.headerDefOffset, v.headerDefOffset + 4);
+						kObjlibBrowser.set_open(r.lib, ObjlibBrowser::kOpenLibrary, isOpen);
+						break;
 					}
-
-					ImGui::PopID();
-
-					if (v.libraryImports.size() > 0 && ImGui::TreeNode("Library Imports")) {
-						for (auto const& import : v.libraryImports)
-							ImGui::TextUnformatted(import.string.c_str());
-
-						ImGui::TreePop();
+					case ObjlibRow::kOrigin: {
+						std::string_view key = kObjlibBrowser.libs[r.lib].key;
+						ImGui::Text("Origin %.*s", static_cast<int>(key.size()), key.data());
+						break;
 					}
-
-					if (v.objectImports.size() > 0 && ImGui::TreeNode("Object Imports")) {
-						for (auto const& import : v.objectImports)
-							ImGui::Text("%s from %s", import.objName.c_str(), import.libraryName.c_str());
-
-						ImGui::TreePop();
+					case ObjlibRow::kJump:
+						if (ImGui::SmallButton("Jump to object definitions")) {
+							selection = &v;
+							memedit.GotoAddrAndHighlight(v.headerDefOffset, v.headerDefOffset + 4);
+						}
+						break;
+					case ObjlibRow::kLibraryImports:
+						node("Library Imports", ObjlibBrowser::kOpenLibraryImports);
+						break;
+					case ObjlibRow::kLibraryImport: {
+						auto const& import = v.libraryImports[r.item];
+						ImGui::TextUnformatted(import.string.data(), import.string.data() + import.string.size());
+						break;
 					}
+					case ObjlibRow::kObjectImports:
+						node("Object Imports", ObjlibBrowser::kOpenObjectImports);
+						break;
+					case ObjlibRow::kObjectImport: {
+						auto const& import = v.objectImports[r.item];
+						ImGui::Text("%.*s from %.*s", static_cast<int>(import.objName.size()), import.objName.data(), static_cast<int>(import.libraryName.size()), import.libraryName.data());
+						break;
+					}
+					case ObjlibRow::kObjects:
+						node("Objects", ObjlibBrowser::kOpenObjects);
+						break;
+					case ObjlibRow::kObject: {
+						auto const& object = v.objects[r.item];
+						char const* typeName = objTypeName(object.type);
+
+						ImGui::PushID(static_cast<int>(r.item));
+
+						// Located definitions open straight from the index, no byte search needed
+						if (object.offset != 0) {
+							if (ImGui::SmallButton("Open")) {
+								selection = &v;
+
+								switch (object.type) {
+								case ObjType::kLeaf: parseModeIdx = 1; break;
+								case ObjType::kMaster: parseModeIdx = 2; break;
+								case ObjType::kSpn: parseModeIdx = 3; break;
+								case ObjType::kSamp: parseModeIdx = 4; break;
+								default: parseModeIdx = 0; break;
+								}
+
+								openDefinition(object.offset, object.length);
+							}
+							ImGui::SameLine();
+						}
 
-					if (v.objects.size() > 0 && ImGui::TreeNode("Objects")) {
-						for (auto const& object : v.objects)
-							ImGui::TextUnformatted(object.name.c_str());
+						if (ImGui::SmallButton("Usages")) {
+							usageQuery = object.name;
+							viewUsages = true;
+						}
+						ImGui::SameLine();
 
-						ImGui::TreePop();
+						ImGui::Text("%s %.*s", typeName ? typeName : "?", static_cast<int>(object.name.size()), object.name.data());
+						ImGui::PopID();
+						break;
+					}
 					}
 
-					ImGui::TreePop();
+					ImGui::PopID();
+					if (depth > 0) ImGui::Unindent(depth * indent);
 				}
 			}
 		}
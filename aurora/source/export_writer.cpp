@@ -0,0 +1,186 @@
+#include "export_writer.hpp"
+
+#include "gathered_write.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <vector>
+
+namespace {
+	constexpr std::string_view kColumnNames[] = {
+		"kind", "file", "type", "name", "library", "hash", "offset", "length", "index", "unknown",
+		"play_mode", "filepath", "channel", "volume", "pitch", "pan", "start",
+		"constraint", "position_x", "position_y", "position_z", "scale_x", "scale_y", "scale_z", "bucket_type",
+		"meshes", "vertices", "triangles",
+	};
+
+	static_assert(std::size(kColumnNames) == aurora::ExportWriter::kColumnCount);
+
+	void append_json_string(std::string& out, std::string_view value) {
+		static constexpr char kHex[] = "0123456789abcdef";
+		out += '"';
+
+		for (char c : value) {
+			switch (c) {
+			case '"': out += "\\\""; break;
+			case '\\': out += "\\\\"; break;
+			case '\n': out += "\\n"; break;
+			case '\r': out += "\\r"; break;
+			case '\t': out += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					out += "\\u00";
+					out += kHex[(c >> 4) & 0xf];
+					out += kHex[c & 0xf];
+				}
+				else out += c;
+			}
+		}
+
+		out += '"';
+	}
+
+	void append_csv_field(std::string& out, std::string_view value) {
+		if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+			out += value;
+			return;
+		}
+
+		out += '"';
+		for (char c : value) {
+			if (c == '"') out += '"';
+			out += c;
+		}
+		out += '"';
+	}
+
+	template <class T>
+	std::string_view format(char (&buffer)[32], T value) {
+		auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+		return { buffer, static_cast<size_t>(end - buffer) };
+	}
+}
+
+std::string aurora::ExportWriter::csv_header() {
+	std::string header;
+	for (size_t i = 0; i < kColumnCount; ++i) {
+		if (i != 0) header += ',';
+		header += kColumnNames[i];
+	}
+	header += '\n';
+	return header;
+}
+
+void aurora::ExportWriter::begin(std::string_view kind) {
+	mRow.clear();
+	mCells.fill({ 0, 0 });
+
+	mJson += '{';
+	key(kColumnNames[kKind]);
+	append_json_string(mJson, kind);
+	mCells[kKind] = { 0, static_cast<uint32_t>(kind.size()) };
+	mRow += kind;
+}
+
+void aurora::ExportWriter::key(std::string_view name) {
+	if (mJson.back() != '{') mJson += ',';
+	mJson += '"';
+	mJson += name;
+	mJson += "\":";
+}
+
+void aurora::ExportWriter::cell(Column column, std::string_view json, std::string_view csv) {
+	key(kColumnNames[column]);
+	mJson += json;
+
+	mCells[column] = { static_cast<uint32_t>(mRow.size()), static_cast<uint32_t>(csv.size()) };
+	mRow += csv;
+}
+
+void aurora::ExportWriter::text(Column column, std::string_view value) {
+	key(kColumnNames[column]);
+	append_json_string(mJson, value);
+
+	mCells[column] = { static_cast<uint32_t>(mRow.size()), static_cast<uint32_t>(value.size()) };
+	mRow += value;
+}
+
+void aurora::ExportWriter::number(Column column, uint64_t value) {
+	char buffer[32];
+	std::string_view formatted = format(buffer, value);
+	cell(column, formatted, formatted);
+}
+
+void aurora::ExportWriter::number(Column column, float value) {
+	// JSON has no spelling for these
+	if (value != value || value - value != 0.0f) {
+		cell(column, "null", "");
+		return;
+	}
+
+	char buffer[32];
+	std::string_view formatted = format(buffer, value);
+	cell(column, formatted, formatted);
+}
+
+void aurora::ExportWriter::hash(Column column, uint32_t value) {
+	char buffer[10] = { '0', '0', '0', '0', '0', '0', '0', '0' };
+	auto [end, error] = std::to_chars(buffer + 8, buffer + sizeof(buffer), value, 16);
+
+	// Right align the digits, to_chars never pads
+	size_t digits = static_cast<size_t>(end - (buffer + 8));
+	memmove(buffer + 8 - digits, buffer + 8, digits);
+	std::string_view hex(buffer, 8);
+
+	key(kColumnNames[column]);
+	mJson += '"';
+	mJson += hex;
+	mJson += '"';
+
+	mCells[column] = { static_cast<uint32_t>(mRow.size()), 8 };
+	mRow += hex;
+}
+
+void aurora::ExportWriter::json_array(std::string_view name, std::span<float const> values) {
+	key(name);
+	mJson += '[';
+
+	for (size_t i = 0; i < values.size(); ++i) {
+		if (i != 0) mJson += ',';
+
+		char buffer[32];
+		if (values[i] != values[i] || values[i] - values[i] != 0.0f) mJson += "null";
+		else mJson += format(buffer, values[i]);
+	}
+
+	mJson += ']';
+}
+
+void aurora::ExportWriter::end() {
+	mJson += "}\n";
+
+	for (size_t i = 0; i < kColumnCount; ++i) {
+		if (i != 0) mCsv += ',';
+		append_csv_field(mCsv, std::string_view(mRow).substr(mCells[i].first, mCells[i].second));
+	}
+
+	mCsv += '\n';
+	++mRows;
+}
+
+bool aurora::write_export(std::filesystem::path const& jsonPath, std::filesystem::path const& csvPath, std::span<ExportWriter const> parts) {
+	std::string const header = ExportWriter::csv_header();
+
+	std::vector<std::span<std::byte const>> json;
+	std::vector<std::span<std::byte const>> csv;
+	json.reserve(parts.size());
+	csv.reserve(parts.size() + 1);
+	csv.push_back(std::as_bytes(std::span(header)));
+
+	for (ExportWriter const& part : parts) {
+		json.push_back(std::as_bytes(std::span(part.json())));
+		csv.push_back(std::as_bytes(std::span(part.csv())));
+	}
+
+	return write_gathered(jsonPath, json) && write_gathered(csvPath, csv);
+}
\ No newline at end of file
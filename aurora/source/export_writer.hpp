@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace aurora {
+	// Rows of the cache export, every row goes out as a JSON object line and as a CSV row
+	// The CSV has one fixed header, the union of every column any kind of row uses. Cells a row doesn't set stay empty.
+	// Numbers are formatted with std::to_chars, floats in their shortest round trip form
+	class ExportWriter final {
+	public:
+		enum Column : uint32_t {
+			kKind,
+			kFile,
+			kType,
+			kName,
+			kLibrary,
+			kHash,
+			kOffset,
+			kLength,
+			kIndex,
+			kUnknown,
+			kPlayMode,
+			kFilepath,
+			kChannel,
+			kVolume,
+			kPitch,
+			kPan,
+			kStart,
+			kConstraint,
+			kPositionX,
+			kPositionY,
+			kPositionZ,
+			kScaleX,
+			kScaleY,
+			kScaleZ,
+			kBucketType,
+			kMeshes,
+			kVertices,
+			kTriangles,
+
+			kColumnCount,
+		};
+
+		static std::string csv_header();
+
+		void begin(std::string_view kind);
+		void text(Column column, std::string_view value);
+		void number(Column column, uint64_t value);
+		void number(Column column, float value);
+		void hash(Column column, uint32_t value); // 8 hex digits, a string in JSON so tools don't need 32 bit integers
+		// JSON only, CSV has no room for nested values
+		void json_array(std::string_view key, std::span<float const> values);
+		void end();
+
+		std::string_view json() const { return mJson; }
+		std::string_view csv() const { return mCsv; }
+		size_t rows() const { return mRows; }
+	private:
+		void key(std::string_view name);
+		void cell(Column column, std::string_view json, std::string_view csv);
+
+		std::string mJson;
+		std::string mCsv;
+		size_t mRows = 0;
+
+		// CSV cells of the open row, ranges into mRow
+		std::string mRow;
+		std::array<std::pair<uint32_t, uint32_t>, kColumnCount> mCells{};
+	};
+
+	// Writes the CSV header once, then every part back to back in order
+	bool write_export(std::filesystem::path const& jsonPath, std::filesystem::path const& csvPath, std::span<ExportWriter const> parts);
+}
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "file_patch.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <system_error>
+
+#ifdef _WIN32
+#	include <Windows.h>
+#else
+#	include <cerrno>
+#	include <fcntl.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace {
+	constexpr size_t kCopyChunk = 1 << 20;
+
+#ifdef _WIN32
+	struct Handle final {
+		HANDLE handle;
+		~Handle() { if (handle != INVALID_HANDLE_VALUE) CloseHandle(handle); }
+	};
+
+	bool write_at(HANDLE handle, uint64_t offset, std::span<std::byte const> bytes) {
+		while (!bytes.empty()) {
+			OVERLAPPED overlapped{};
+			overlapped.Offset = static_cast<DWORD>(offset);
+			overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+			DWORD written = 0;
+			if (!WriteFile(handle, bytes.data(), static_cast<DWORD>(std::min<size_t>(bytes.size(), kCopyChunk)), &written, &overlapped)) return false;
+
+			offset += written;
+			bytes = bytes.subspan(written);
+		}
+
+		return true;
+	}
+
+	bool copy_range(HANDLE source, uint64_t sourceOffset, HANDLE destination, uint64_t destinationOffset, size_t count) {
+		auto buffer = std::make_unique_for_overwrite<std::byte[]>(kCopyChunk);
+
+		while (count > 0) {
+			OVERLAPPED overlapped{};
+			overlapped.Offset = static_cast<DWORD>(sourceOffset);
+			overlapped.OffsetHigh = static_cast<DWORD>(sourceOffset >> 32);
+
+			DWORD read = 0;
+			if (!ReadFile(source, buffer.get(), static_cast<DWORD>(std::min(count, kCopyChunk)), &read, &overlapped) || read == 0) return false;
+			if (!write_at(destination, destinationOffset, { buffer.get(), read })) return false;
+
+			sourceOffset += read;
+			destinationOffset += read;
+			count -= read;
+		}
+
+		return true;
+	}
+#else
+	struct Fd final {
+		int fd;
+		~Fd() { if (fd != -1) ::close(fd); }
+	};
+
+	bool write_at(int fd, off_t offset, std::span<std::byte const> bytes) {
+		while (!bytes.empty()) {
+			ssize_t written = ::pwrite(fd, bytes.data(), bytes.size(), offset);
+			if (written < 0) {
+				if (errno == EINTR) continue;
+				return false;
+			}
+
+			offset += written;
+			bytes = bytes.subspan(static_cast<size_t>(written));
+		}
+
+		return true;
+	}
+
+	// Falls back to a plain read and write loop where the kernel can't copy between the two files itself
+	bool copy_range(int source, off_t sourceOffset, int destination, off_t destinationOffset, size_t count) {
+#	ifdef __linux__
+		while (count > 0) {
+			ssize_t copied = ::copy_file_range(source, &sourceOffset, destination, &destinationOffset, count, 0);
+			if (copied < 0) {
+				if (errno == EINTR) continue;
+				if (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP) break;
+				return false;
+			}
+
+			if (copied == 0) return false; // Source ended early
+			count -= static_cast<size_t>(copied);
+		}
+
+		if (count == 0) return true;
+#	endif
+
+		auto buffer = std::make_unique_for_overwrite<std::byte[]>(kCopyChunk);
+
+		while (count > 0) {
+			ssize_t read = ::pread(source, buffer.get(), std::min(count, kCopyChunk), sourceOffset);
+			if (read < 0) {
+				if (errno == EINTR) continue;
+				return false;
+			}
+
+			if (read == 0) return false;
+			if (!write_at(destination, destinationOffset, { buffer.get(), static_cast<size_t>(read) })) return false;
+
+			sourceOffset += read;
+			destinationOffset += read;
+			count -= static_cast<size_t>(read);
+		}
+
+		return true;
+	}
+#endif
+}
+
+bool aurora::patch_file(std::filesystem::path const& path, std::span<FilePatch const> patches) {
+	std::error_code ec;
+	uintmax_t fileSize = std::filesystem::file_size(path, ec);
+	if (ec) return false;
+
+	bool sameSize = true;
+	size_t previousEnd = 0;
+
+	for (FilePatch const& patch : patches) {
+		if (patch.offset < previousEnd || patch.offset > fileSize || fileSize - patch.offset < patch.size) return false;
+		previousEnd = patch.offset + patch.size;
+		sameSize &= patch.replacement.size() == patch.size;
+	}
+
+	std::filesystem::path temporary = path;
+	temporary += ".tmp";
+
+#ifdef _WIN32
+	if (sameSize) {
+		Handle file{ CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+		if (file.handle == INVALID_HANDLE_VALUE) return false;
+
+		for (FilePatch const& patch : patches)
+			if (!write_at(file.handle, patch.offset, patch.replacement)) return false;
+		return true;
+	}
+
+	bool ok = true;
+
+	{
+		Handle source{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+		if (source.handle == INVALID_HANDLE_VALUE) return false;
+
+		Handle destination{ CreateFileW(temporary.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+		if (destination.handle == INVALID_HANDLE_VALUE) return false;
+
+		// Source and destination positions drift apart by the size difference of every patch so far
+		uint64_t sourceOffset = 0;
+		uint64_t destinationOffset = 0;
+
+		for (FilePatch const& patch : patches) {
+			size_t gap = patch.offset - sourceOffset;
+			ok = ok && copy_range(source.handle, sourceOffset, destination.handle, destinationOffset, gap)
+				&& write_at(destination.handle, destinationOffset + gap, patch.replacement);
+
+			sourceOffset = patch.offset + patch.size;
+			destinationOffset += gap + patch.replacement.size();
+		}
+
+		ok = ok && copy_range(source.handle, sourceOffset, destination.handle, destinationOffset, static_cast<size_t>(fileSize - sourceOffset))
+			&& FlushFileBuffers(destination.handle);
+	}
+#else
+	if (sameSize) {
+		Fd file{ ::open(path.c_str(), O_WRONLY | O_CLOEXEC) };
+		if (file.fd == -1) return false;
+
+		for (FilePatch const& patch : patches)
+			if (!write_at(file.fd, static_cast<off_t>(patch.offset), patch.replacement)) return false;
+		return true;
+	}
+
+	bool ok = true;
+
+	{
+		Fd source{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+		if (source.fd == -1) return false;
+
+		struct stat info;
+		if (fstat(source.fd, &info) != 0) return false;
+
+		Fd destination{ ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, info.st_mode & 07777) };
+		if (destination.fd == -1) return false;
+
+		// Source and destination positions drift apart by the size difference of every patch so far
+		size_t sourceOffset = 0;
+		size_t destinationOffset = 0;
+
+		for (FilePatch const& patch : patches) {
+			size_t gap = patch.offset - sourceOffset;
+			ok = ok && copy_range(source.fd, static_cast<off_t>(sourceOffset), destination.fd, static_cast<off_t>(destinationOffset), gap)
+				&& write_at(destination.fd, static_cast<off_t>(destinationOffset + gap), patch.replacement);
+
+			sourceOffset = patch.offset + patch.size;
+			destinationOffset += gap + patch.replacement.size();
+		}
+
+		ok = ok && copy_range(source.fd, static_cast<off_t>(sourceOffset), destination.fd, static_cast<off_t>(destinationOffset), static_cast<size_t>(fileSize) - sourceOffset)
+			&& ::fsync(destination.fd) == 0;
+	}
+#endif
+
+	// Both files are closed here, readers see either the old or the new file, never a partial one
+	if (ok) std::filesystem::rename(temporary, path, ec);
+
+	if (!ok || ec) {
+		std::error_code ignored;
+		std::filesystem::remove(temporary, ignored);
+		return false;
+	}
+
+	return true;
+}
\ No newline at end of file
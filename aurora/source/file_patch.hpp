@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace aurora {
+	// Replaces the `size` bytes at `offset` with `replacement`, offsets refer to the file before any patch is applied
+	struct FilePatch {
+		size_t offset;
+		size_t size;
+		std::span<std::byte const> replacement;
+	};
+
+	// Applies every patch to an existing file in one pass, `patches` must be sorted by offset and must not overlap
+	// If no patch changes the file size they are written in place, nothing else in the file is touched
+	// Otherwise a temporary copy is spliced together with copy_file_range, where the kernel can share or copy
+	// the untouched ranges without them ever passing through this process, and renamed over the original
+	// On Windows the file must not be mapped when the size changes, the rename fails on mapped files
+	bool patch_file(std::filesystem::path const& path, std::span<FilePatch const> patches);
+
+	inline bool patch_file(std::filesystem::path const& path, size_t offset, size_t size, std::span<std::byte const> replacement) {
+		FilePatch patch{ offset, size, replacement };
+		return patch_file(path, std::span(&patch, 1));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "gathered_write.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef _WIN32
+#	include <Windows.h>
+#else
+#	include <cerrno>
+#	include <climits>
+#	include <fcntl.h>
+#	include <sys/uio.h>
+#	include <unistd.h>
+#endif
+
+bool aurora::write_gathered(std::filesystem::path const& path, std::span<std::span<std::byte const> const> pieces) {
+#ifdef _WIN32
+	// WriteFileGather only takes page aligned, page sized buffers on unbuffered handles, so write the pieces in sequence
+	HANDLE handle = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) return false;
+
+	for (std::span<std::byte const> piece : pieces) {
+		while (!piece.empty()) {
+			DWORD chunk = static_cast<DWORD>(std::min<size_t>(piece.size(), 1u << 30));
+			DWORD written = 0;
+
+			if (!WriteFile(handle, piece.data(), chunk, &written, nullptr)) {
+				CloseHandle(handle);
+				return false;
+			}
+
+			piece = piece.subspan(written);
+		}
+	}
+
+	return CloseHandle(handle);
+#else
+	int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd == -1) return false;
+
+	std::vector<iovec> vectors;
+	vectors.reserve(pieces.size());
+	for (std::span<std::byte const> piece : pieces)
+		if (!piece.empty())
+			vectors.push_back({ const_cast<std::byte*>(piece.data()), piece.size() });
+
+	// Short writes are legal, resume from wherever the kernel stopped
+	size_t first = 0;
+	while (first < vectors.size()) {
+		int count = static_cast<int>(std::min<size_t>(vectors.size() - first, IOV_MAX));
+		ssize_t written = ::writev(fd, vectors.data() + first, count);
+
+		if (written < 0) {
+			if (errno == EINTR) continue;
+			::close(fd);
+			return false;
+		}
+
+		size_t remaining = static_cast<size_t>(written);
+		while (first < vectors.size() && remaining >= vectors[first].iov_len)
+			remaining -= vectors[first++].iov_len;
+
+		if (remaining > 0) {
+			vectors[first].iov_base = static_cast<char*>(vectors[first].iov_base) + remaining;
+			vectors[first].iov_len -= remaining;
+		}
+	}
+
+	return ::close(fd) == 0;
+#endif
+}
\ No newline at end of file
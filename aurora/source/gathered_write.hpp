@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace aurora {
+	// Replaces the contents of `path` with every piece back to back
+	// POSIX hands all pieces to the kernel in one writev call, no staging buffer is ever built
+	bool write_gathered(std::filesystem::path const& path, std::span<std::span<std::byte const> const> pieces);
+}
\ No newline at end of file
@@ -0,0 +1,410 @@
+#include "hash_cracker.hpp"
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#	define AURORA_X64 1
+#	include <immintrin.h>
+#	if defined(_MSC_VER) && !defined(__clang__)
+#		include <intrin.h>
+#	endif
+#endif
+
+// MSVC compiles intrinsics for any instruction set as is, GCC and Clang only inside functions targeting it
+#if defined(__GNUC__) || defined(__clang__)
+#	define AURORA_TARGET(features) __attribute__((target(features)))
+#else
+#	define AURORA_TARGET(features)
+#endif
+
+namespace {
+	constexpr uint32_t kBasis = 0x811c9dc5;
+	constexpr uint32_t kPrime = 0x1000193;
+	constexpr size_t kMaxAlternatives = size_t(1) << 24;
+	constexpr uint64_t kMaxCandidates = uint64_t(1) << 48;
+	constexpr uint64_t kUnitSize = 1 << 16; // Candidates per parallel_for index
+	constexpr size_t kLanes = 16; // Group width, AVX2 runs every group as two halves
+
+	// Same steps as aurora::hash32, split so a shared prefix is only hashed once
+	uint32_t fnv(uint32_t h, std::string_view text) {
+		for (char c : text)
+			h = (h ^ static_cast<unsigned char>(c)) * kPrime;
+		return h;
+	}
+
+	uint32_t finish(uint32_t h) {
+		h *= 0x2001;
+		h = (h ^ (h >> 0x7)) * 0x9;
+		h = (h ^ (h >> 0x11)) * 0x21;
+		return h;
+	}
+
+	// The widest part of a grammar, transposed into groups of kLanes alternatives sorted by length
+	// Byte j of lane l sits at columns[offset + j * kLanes + l], shorter alternatives are zero padded
+	struct Lanes {
+		std::vector<std::string> alternatives;
+		std::vector<uint8_t> columns;
+		std::vector<uint32_t> lengths; // Padded to whole groups
+		std::vector<size_t> offsets;
+		std::vector<uint32_t> widths;
+	};
+
+	Lanes transpose(std::vector<std::string> alternatives) {
+		std::stable_sort(alternatives.begin(), alternatives.end(), [](std::string const& a, std::string const& b) { return a.size() < b.size(); });
+
+		Lanes lanes;
+		size_t const groups = (alternatives.size() + kLanes - 1) / kLanes;
+		lanes.lengths.resize(groups * kLanes, 0);
+
+		for (size_t group = 0; group < groups; ++group) {
+			size_t const last = std::min(alternatives.size(), (group + 1) * kLanes) - 1;
+			uint32_t const width = static_cast<uint32_t>(alternatives[last].size());
+
+			lanes.offsets.push_back(lanes.columns.size());
+			lanes.widths.push_back(width);
+			lanes.columns.resize(lanes.columns.size() + width * kLanes, 0);
+
+			for (size_t lane = 0; lane < kLanes && group * kLanes + lane <= last; ++lane) {
+				std::string const& alternative = alternatives[group * kLanes + lane];
+				for (size_t j = 0; j < alternative.size(); ++j)
+					lanes.columns[lanes.offsets.back() + j * kLanes + lane] = static_cast<uint8_t>(alternative[j]);
+
+				lanes.lengths[group * kLanes + lane] = static_cast<uint32_t>(alternative.size());
+			}
+		}
+
+		lanes.alternatives = std::move(alternatives);
+		return lanes;
+	}
+
+	struct Group {
+		uint8_t const* columns;
+		uint32_t const* lengths;
+		uint32_t width;
+	};
+
+	using HashGroupFn = void (*)(uint32_t seed, Group group, std::string_view suffix, uint32_t* out);
+
+	// Lanes are independent, compilers vectorize this with whatever the baseline target allows
+	void hash_group_scalar(uint32_t seed, Group group, std::string_view suffix, uint32_t* out) {
+		uint32_t h[kLanes];
+		for (size_t lane = 0; lane < kLanes; ++lane)
+			h[lane] = seed;
+
+		for (uint32_t j = 0; j < group.width; ++j)
+			for (size_t lane = 0; lane < kLanes; ++lane)
+				if (j < group.lengths[lane]) h[lane] = (h[lane] ^ group.columns[j * kLanes + lane]) * kPrime;
+
+		for (char c : suffix)
+			for (size_t lane = 0; lane < kLanes; ++lane)
+				h[lane] = (h[lane] ^ static_cast<unsigned char>(c)) * kPrime;
+
+		for (size_t lane = 0; lane < kLanes; ++lane)
+			out[lane] = finish(h[lane]);
+	}
+
+#ifdef AURORA_X64
+	AURORA_TARGET("avx2")
+	void hash_group_avx2(uint32_t seed, Group group, std::string_view suffix, uint32_t* out) {
+		__m256i const prime = _mm256_set1_epi32(kPrime);
+
+		for (size_t half = 0; half < kLanes; half += 8) {
+			__m256i h = _mm256_set1_epi32(static_cast<int>(seed));
+			__m256i const lengths = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(group.lengths + half));
+
+			for (uint32_t j = 0; j < group.width; ++j) {
+				__m256i bytes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(group.columns + j * kLanes + half)));
+				__m256i next = _mm256_mullo_epi32(_mm256_xor_si256(h, bytes), prime);
+				__m256i active = _mm256_cmpgt_epi32(lengths, _mm256_set1_epi32(static_cast<int>(j)));
+				h = _mm256_blendv_epi8(h, next, active);
+			}
+
+			for (char c : suffix)
+				h = _mm256_mullo_epi32(_mm256_xor_si256(h, _mm256_set1_epi32(static_cast<unsigned char>(c))), prime);
+
+			h = _mm256_mullo_epi32(h, _mm256_set1_epi32(0x2001));
+			h = _mm256_mullo_epi32(_mm256_xor_si256(h, _mm256_srli_epi32(h, 0x7)), _mm256_set1_epi32(0x9));
+			h = _mm256_mullo_epi32(_mm256_xor_si256(h, _mm256_srli_epi32(h, 0x11)), _mm256_set1_epi32(0x21));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + half), h);
+		}
+	}
+
+	AURORA_TARGET("avx512f")
+	void hash_group_avx512(uint32_t seed, Group group, std::string_view suffix, uint32_t* out) {
+		__m512i const prime = _mm512_set1_epi32(kPrime);
+		__m512i const lengths = _mm512_loadu_si512(group.lengths);
+		__m512i h = _mm512_set1_epi32(static_cast<int>(seed));
+
+		for (uint32_t j = 0; j < group.width; ++j) {
+			__m512i bytes = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(group.columns + j * kLanes)));
+			__mmask16 active = _mm512_cmpgt_epi32_mask(lengths, _mm512_set1_epi32(static_cast<int>(j)));
+			h = _mm512_mask_mullo_epi32(h, active, _mm512_xor_si512(h, bytes), prime);
+		}
+
+		for (char c : suffix)
+			h = _mm512_mullo_epi32(_mm512_xor_si512(h, _mm512_set1_epi32(static_cast<unsigned char>(c))), prime);
+
+		h = _mm512_mullo_epi32(h, _mm512_set1_epi32(0x2001));
+		h = _mm512_mullo_epi32(_mm512_xor_si512(h, _mm512_srli_epi32(h, 0x7)), _mm512_set1_epi32(0x9));
+		h = _mm512_mullo_epi32(_mm512_xor_si512(h, _mm512_srli_epi32(h, 0x11)), _mm512_set1_epi32(0x21));
+		_mm512_storeu_si512(out, h);
+	}
+#endif
+
+	HashGroupFn kernel_for(aurora::SimdLevel level) {
+#ifdef AURORA_X64
+		if (level == aurora::SimdLevel::kAvx512) return hash_group_avx512;
+		if (level == aurora::SimdLevel::kAvx2) return hash_group_avx2;
+#endif
+		return hash_group_scalar;
+	}
+
+	// `{lower-upper}`, returns false if `body` isn't a range
+	bool parse_range(std::string_view body, std::vector<std::string>& alternatives, bool& valid) {
+		size_t dash = body.find('-');
+		if (dash == std::string_view::npos || dash == 0 || dash + 1 == body.size()) return false;
+
+		std::string_view lowerText = body.substr(0, dash);
+		std::string_view upperText = body.substr(dash + 1);
+		auto digits = [](std::string_view text) { return std::all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; }); };
+		if (!digits(lowerText) || !digits(upperText)) return false;
+
+		uint64_t lower = 0, upper = 0;
+		auto [lowerEnd, lowerError] = std::from_chars(lowerText.data(), lowerText.data() + lowerText.size(), lower);
+		auto [upperEnd, upperError] = std::from_chars(upperText.data(), upperText.data() + upperText.size(), upper);
+		if (lowerError != std::errc() || upperError != std::errc() || lower > upper || upper - lower >= kMaxAlternatives) {
+			valid = false;
+			return true;
+		}
+
+		size_t const width = lowerText.size();
+		alternatives.reserve(upper - lower + 1);
+
+		for (uint64_t value = lower; value <= upper; ++value) {
+			char buffer[24];
+			auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			size_t length = static_cast<size_t>(end - buffer);
+
+			std::string& number = alternatives.emplace_back(width > length ? width - length : 0, '0');
+			number.append(buffer, length);
+		}
+
+		return true;
+	}
+}
+
+std::optional<aurora::HashGrammar> aurora::HashGrammar::parse(std::string_view text, std::span<std::string const> words) {
+	HashGrammar grammar;
+	std::string literal;
+
+	for (size_t i = 0; i < text.size();) {
+		char c = text[i];
+		if (c == '}') return std::nullopt;
+
+		if (c != '{') {
+			literal += c;
+			++i;
+			continue;
+		}
+
+		size_t close = text.find('}', i);
+		if (close == std::string_view::npos) return std::nullopt;
+
+		std::string_view body = text.substr(i + 1, close - i - 1);
+		i = close + 1;
+
+		if (!literal.empty()) grammar.parts.push_back({ std::move(literal) });
+		literal.clear();
+
+		std::vector<std::string> alternatives;
+		bool valid = true;
+
+		if (body == "words") {
+			alternatives.assign(words.begin(), words.end());
+		}
+		else if (!parse_range(body, alternatives, valid)) {
+			// Empty alternatives are allowed, `{|_}` is an optional underscore
+			for (size_t begin = 0; begin <= body.size();) {
+				size_t end = std::min(body.find('|', begin), body.size());
+				alternatives.emplace_back(body.substr(begin, end - begin));
+				begin = end + 1;
+			}
+		}
+
+		if (!valid || alternatives.empty() || alternatives.size() > kMaxAlternatives) return std::nullopt;
+		grammar.parts.push_back(std::move(alternatives));
+	}
+
+	if (!literal.empty()) grammar.parts.push_back({ std::move(literal) });
+	if (grammar.parts.empty() || grammar.size() > kMaxCandidates) return std::nullopt;
+	return grammar;
+}
+
+uint64_t aurora::HashGrammar::size() const {
+	uint64_t size = 1;
+
+	for (auto const& part : parts) {
+		if (part.empty()) return 0;
+		if (size > UINT64_MAX / part.size()) return UINT64_MAX;
+		size *= part.size();
+	}
+
+	return size;
+}
+
+aurora::SimdLevel aurora::detect_simd_level() {
+#ifdef AURORA_X64
+#	if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 1);
+	if (!(info[2] & (1 << 27))) return SimdLevel::kScalar; // The OS doesn't save the wide registers
+
+	uint64_t enabled = _xgetbv(0);
+	__cpuidex(info, 7, 0);
+	if ((info[1] & (1 << 16)) && (enabled & 0xe6) == 0xe6) return SimdLevel::kAvx512;
+	if ((info[1] & (1 << 5)) && (enabled & 0x6) == 0x6) return SimdLevel::kAvx2;
+#	else
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return SimdLevel::kAvx512;
+	if (__builtin_cpu_supports("avx2")) return SimdLevel::kAvx2;
+#	endif
+#endif
+	return SimdLevel::kScalar;
+}
+
+char const* aurora::simd_level_name(SimdLevel level) {
+	switch (level) {
+	case SimdLevel::kAvx512: return "AVX-512";
+	case SimdLevel::kAvx2: return "AVX2";
+	default: return "Scalar";
+	}
+}
+
+void aurora::HashCracker::start(std::vector<HashGrammar> grammars, std::vector<uint32_t> targets, SimdLevel level) {
+	cancel();
+
+	mGrammars = std::move(grammars);
+	mTargets = std::move(targets);
+	std::sort(mTargets.begin(), mTargets.end());
+	mTargets.erase(std::unique(mTargets.begin(), mTargets.end()), mTargets.end());
+
+	mFilter.assign((1 << 20) / 64, 0);
+	for (uint32_t target : mTargets)
+		mFilter[(target >> 12) / 64] |= uint64_t(1) << ((target >> 12) % 64);
+
+	mLevel = std::min(level, detect_simd_level());
+	mTotal = 0;
+	for (HashGrammar const& grammar : mGrammars)
+		mTotal += std::min(grammar.size(), UINT64_MAX - mTotal);
+
+	mPending.clear();
+	mCancel = false;
+	mRunning = true;
+	mTested = 0;
+	mElapsed = 0;
+	mBegin = std::chrono::steady_clock::now();
+
+	mThread = std::thread([this]() {
+		for (HashGrammar const& grammar : mGrammars)
+			if (!mCancel && !mTargets.empty()) run(grammar);
+
+		mElapsed = (std::chrono::steady_clock::now() - mBegin).count();
+		mRunning = false;
+	});
+}
+
+void aurora::HashCracker::run(HashGrammar const& grammar) {
+	auto const& parts = grammar.parts;
+
+	size_t wide = 0;
+	for (size_t i = 1; i < parts.size(); ++i)
+		if (parts[i].size() > parts[wide].size()) wide = i;
+
+	Lanes const lanes = transpose(parts[wide]);
+	HashGroupFn const hash_group = kernel_for(mLevel);
+	uint64_t const wideCount = lanes.alternatives.size();
+	uint64_t const total = grammar.size();
+
+	// Candidates are numbered with the wide part as the fastest changing digit, every unit is a contiguous run of them
+	aurora::parallel_for(total / kUnitSize + (total % kUnitSize != 0), [&](size_t unit, unsigned) {
+		if (mCancel) return;
+
+		uint64_t const begin = unit * kUnitSize;
+		uint64_t const end = begin + std::min(kUnitSize, total - begin);
+
+		// Digits of every other part, the last part changes fastest
+		std::vector<size_t> digits(parts.size(), 0);
+		uint64_t combination = begin / wideCount;
+		for (size_t i = parts.size(); i-- > 0;) {
+			if (i == wide) continue;
+			digits[i] = combination % parts[i].size();
+			combination /= parts[i].size();
+		}
+
+		std::vector<Hit> hits;
+		std::string prefix, suffix;
+		uint32_t hashes[kLanes];
+		uint64_t first = begin % wideCount;
+
+		for (uint64_t position = begin; position < end;) {
+			prefix.clear();
+			suffix.clear();
+			for (size_t i = 0; i < parts.size(); ++i)
+				if (i != wide) (i < wide ? prefix : suffix) += parts[i][digits[i]];
+
+			uint32_t const seed = fnv(kBasis, prefix);
+			uint64_t const last = std::min(wideCount, first + (end - position));
+
+			for (size_t group = first / kLanes; group * kLanes < last; ++group) {
+				hash_group(seed, { lanes.columns.data() + lanes.offsets[group], lanes.lengths.data() + group * kLanes, lanes.widths[group] }, suffix, hashes);
+
+				for (size_t lane = 0; lane < kLanes; ++lane) {
+					uint32_t const hash = hashes[lane];
+					if (!(mFilter[(hash >> 12) / 64] & (uint64_t(1) << ((hash >> 12) % 64)))) continue;
+
+					size_t const index = group * kLanes + lane;
+					if (index < first || index >= last) continue;
+					if (!std::binary_search(mTargets.begin(), mTargets.end(), hash)) continue;
+
+					hits.push_back({ hash, prefix + lanes.alternatives[index] + suffix });
+				}
+			}
+
+			position += last - first;
+			first = 0;
+
+			for (size_t i = parts.size(); i-- > 0;) {
+				if (i == wide) continue;
+				if (++digits[i] < parts[i].size()) break;
+				digits[i] = 0;
+			}
+		}
+
+		mTested += end - begin;
+
+		if (!hits.empty()) {
+			std::lock_guard lock(mMutex);
+			mPending.insert(mPending.end(), std::make_move_iterator(hits.begin()), std::make_move_iterator(hits.end()));
+		}
+	});
+}
+
+void aurora::HashCracker::cancel() {
+	mCancel = true;
+	if (mThread.joinable()) mThread.join();
+}
+
+void aurora::HashCracker::collect(std::vector<Hit>& hits) {
+	std::lock_guard lock(mMutex);
+	hits.insert(hits.end(), std::make_move_iterator(mPending.begin()), std::make_move_iterator(mPending.end()));
+	mPending.clear();
+}
+
+double aurora::HashCracker::seconds() const {
+	auto elapsed = mRunning ? std::chrono::steady_clock::now() - mBegin : std::chrono::steady_clock::duration(mElapsed.load());
+	return std::chrono::duration<double>(elapsed).count();
+}
\ No newline at end of file
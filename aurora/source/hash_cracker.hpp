@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace aurora {
+	// Candidate names described as a sequence of parts, every candidate picks one alternative of each part in order
+	// Text form: literal text, `{a|b|c}` alternatives, `{0-99}` numbers (`{00-99}` zero pads to the width of the lower bound)
+	// and `{words}`, which expands to the word list given to `parse`
+	struct HashGrammar {
+		std::vector<std::vector<std::string>> parts;
+
+		// Returns std::nullopt on malformed text, a part with more than 16M alternatives or more than 2^48 candidates,
+		// which already takes hours on the widest kernel
+		static std::optional<HashGrammar> parse(std::string_view text, std::span<std::string const> words);
+
+		// Saturates at UINT64_MAX
+		uint64_t size() const;
+	};
+
+	enum struct SimdLevel {
+		kScalar,
+		kAvx2,
+		kAvx512,
+	};
+
+	// Widest kernel this CPU runs
+	SimdLevel detect_simd_level();
+	char const* simd_level_name(SimdLevel level);
+
+	// Hashes every candidate of a list of grammars on all cores, keeping the ones that hit a target hash
+	// Candidates are hashed 16 (AVX-512) or 8 (AVX2) at a time, one lane each, the widest part of a grammar is spread
+	// across the lanes while every other part is shared by all of them
+	class HashCracker final {
+	public:
+		struct Hit {
+			uint32_t hash;
+			std::string name;
+		};
+
+		HashCracker() = default;
+		HashCracker(HashCracker const&) = delete;
+		HashCracker& operator=(HashCracker const&) = delete;
+		~HashCracker() { cancel(); }
+
+		// Cancels any run still going first
+		void start(std::vector<HashGrammar> grammars, std::vector<uint32_t> targets, SimdLevel level = detect_simd_level());
+		void cancel();
+
+		// Moves the hits found since the last call to the end of `hits`
+		void collect(std::vector<Hit>& hits);
+
+		bool running() const { return mRunning; }
+		uint64_t tested() const { return mTested; }
+		uint64_t total() const { return mTotal; }
+		SimdLevel level() const { return mLevel; }
+		double seconds() const;
+	private:
+		void run(HashGrammar const& grammar);
+
+		std::vector<HashGrammar> mGrammars;
+		std::vector<uint32_t> mTargets; // Sorted
+		std::vector<uint64_t> mFilter; // One bit per top 20 bits of a target
+		SimdLevel mLevel = SimdLevel::kScalar;
+
+		std::thread mThread;
+		std::atomic_bool mCancel = false;
+		std::atomic_bool mRunning = false;
+		std::atomic_uint64_t mTested = 0;
+		uint64_t mTotal = 0;
+		std::chrono::steady_clock::time_point mBegin;
+		std::atomic<std::chrono::steady_clock::duration::rep> mElapsed = 0;
+
+		std::mutex mMutex;
+		std::vector<Hit> mPending;
+	};
+}
\ No newline at end of file
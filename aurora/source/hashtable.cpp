@@ -1,182 +1,490 @@
 #include "hashtable.hpp"
 
-char const* aurora::lookupHash(uint32_t hash) {
-	switch (hash) {
-	// --- undocumented ---
-	case 0x63259f0a: return "AnimComp";
-	case 0x3c8efb12: return "EditStateComp";
-	case 0x84e761eb: return "XfmComp";
-
-	// --- object parameters ---
-
-	// .lvl objects
-	case 0xe04f3144: return "layer_volume";
-	// .leaf objects
-	case 0x90db6c5c: return "pitch";
-	case 0x461da26a: return "roll";
-	case 0x659c0bb8: return "turn";
-	case 0x1e470b5d: return "turn_auto";
-	case 0xb44b9ff1: return "scale_x";
-	case 0x5c01c2b9: return "scale_y";
-	case 0x2794bcce: return "scale_z";
-	case 0x2e08b151: return "offset_x";
-	case 0xfa4ab34f: return "offset_y";
-	case 0x1ff804bc: return "offset_z";
-	case 0x48697144: return "visibla01";
-	case 0x842a58fa: return "visibla02";
-	case 0xa444acf9: return "visible";
-	case 0x93dcfe04: return "visiblz01";
-	case 0x7ce4037d: return "visiblz02";
-	// avatar .objlib objects
-	case 0x7ec6de5f: return "sequin_speed";
-	case 0x45e125b3: return "win";
-	case 0xf31f3243: return "win_checkpoint";
-	case 0xd37839a4: return "win_checkpoint_silent";
-	// .samp objects
-	case 0x82bb9c74: return "play";
-	case 0x7a2ec56d: return "play_clean";
-	case 0xa21622fa: return "pause";
-	case 0x0bb8ea4b: return "resume";
-	case 0x9fa68571: return "stop";
-	// .mat objects
-	case 0x13bdaa3b: return "emissive_color";
-	case 0x7d06b11c: return "ambient_color";
-	case 0x3dfe8a74: return "diffuse_color";
-	case 0xd7b602ce: return "specular_color";
-	case 0x1ca08372: return "reflectivity_color";
-	case 0x52a06bf4: return "alpha";
-	// .anim objects
-	case 0xb3b5d9f1: return "frame";
-
-	// --- interactive player objects ---
-
-	// .spn objects: decorators/thump_rails.objlib
-	case 0x52d7447a: return "thump_rails.a01";
-	case 0x583cc8c2: return "thump_rails.a02";
-	case 0x4477bbd4: return "thump_rails.ent";
-	case 0xdc12888d: return "thump_rails.z01";
-	case 0xbbf22741: return "thump_rails.z02";
-	case 0x897c516b: return "thump_checkpoint.ent";
-	case 0xadfa9f2c: return "thump_rails_fast_activat.ent";
-	case 0x4733a5e6: return "thump_boss_bonus.ent";
-	// .spn objects: decorators/thump_grindable.objlib
-	case 0x51b93243: return "grindable_still.ent";
-	case 0xcf53c501: return "left_multi.a01";
-	case 0xbecb71fa: return "left_multi.a02";
-	case 0x6e5b2576: return "left_multi.ent";
-	case 0xd528868a: return "left_multi.z01";
-	case 0xb9e107fc: return "center_multi.a02";
-	case 0xed5a7e91: return "center_multi.ent";
-	case 0xe27b6c3c: return "center_multi.z01";
-	case 0x99f4653e: return "right_multi.a02";
-	case 0x1e0ae961: return "right_multi.ent";
-	case 0x03fd4938: return "right_multi.z01";
-	case 0x73b0f245: return "right_multi.z02";
-	// .spn objects : decorators / thump_grindable_multi.objlib
-	case 0x3e774af9: return "grindable_quarters.ent";
-	case 0x73af2bae: return "grindable_double.ent";
-	case 0x2216f6df: return "grindable_thirds.ent";
-	case 0x8b3738a4: return "grindable_with_thump.ent";
-	// 	.spn objects: decorators/ducker.objlib
-	case 0xc933e313: return "ducker_crak.ent";
-	// .spn objects : decorators / jumper / jumper_set.objlib
-	case 0x0743418a: return "jumper_1_step.ent";
-	case 0x2eb30851: return "jumper_boss.ent";
-	case 0x8d55abe4: return "jumper_6_step.ent";
-	// .spn objects: decorators/jump_high/jump_high_set.objlib
-	case 0xb886b204: return "jump_high.ent";
-	case 0x9b004f93: return "jump_high_2.ent";
-	case 0xcdfddfc4: return "jump_high_4.ent";
-	case 0x10be3b0b: return "jump_high_6.ent";
-	case 0x0ef04fb0: return "jump_boss.ent";
-	// .spn objects : decorators / obstacles / wurms / millipede_half.objlib
-	case 0x601c9d22: return "swerve_off.a01";
-	case 0xd881767c: return "swerve_off.a02";
-	case 0x3f602426: return "swerve_off.ent";
-	case 0xc92199c0: return "swerve_off.z01";
-	case 0x0d0004b1: return "swerve_off.z02";
-	case 0x43eae5dd: return "millipede_half.a01";
-	case 0xce42c1bf: return "millipede_half.a02";
-	case 0xbe018127: return "millipede_half.ent";
-	case 0xb01d4126: return "millipede_half.z01";
-	case 0x45b829c9: return "millipede_half.z02";
-	case 0xbf2a2b2a: return "millipede_half_phrase.a01";
-	case 0xcacf6bea: return "millipede_half_phrase.a02";
-	case 0xbbaf4e32: return "millipede_half_phrase.ent";
-	case 0xf53455f0: return "millipede_half_phrase.z01";
-	case 0xf28e0216: return "millipede_half_phrase.z02";
-	// .spn objects: decorators/obstacles/wurms/millipede_quarter.objlib
-	case 0x366799e4: return "millipede_quarter.a01";
-	case 0x40b25fd4: return "millipede_quarter.a02";
-	case 0x1703ae12: return "millipede_quarter.ent";
-	case 0x66ac1596: return "millipede_quarter.z01";
-	case 0xdb0dba2f: return "millipede_quarter.z02";
-	case 0x041539b3: return "millipede_quarter_phrase.a01";
-	case 0x4c1c613a: return "millipede_quarter_phrase.a02";
-	case 0x1d2ce5f4: return "millipede_quarter_phrase.ent";
-	case 0x0bc1ab97: return "millipede_quarter_phrase.z01";
-	case 0x1e48e54e: return "millipede_quarter_phrase.z02";
-	// .spn objects: decorators/sentry.objlib
-	case 0xf1e67274: return "sentry.ent";
-	case 0x8792db5a: return "level_9.ent";
-	case 0x32eb179b: return "level_5.ent";
-	case 0x476dfd28: return "level_8.ent";
-	case 0x32e9a51e: return "sentry_boss.ent";
-	case 0xbfeb686e: return "level_7.ent";
-	case 0xac58b0b9: return "level_6.ent";
-	case 0xc70f3afd: return "sentry_boss_multilane.ent";
-	case 0xb4034d58: return "level_8_multi.ent";
-	case 0xb87c60e8: return "level_9_multi.ent";
-
-	// --- decorative objects ---
-
-	// .spn objects: decorators/jump_high/jump_high_big_trees_set.objlib
-	case 0xa8d60562: return "trees.ent";
-	case 0xbb63511d: return "trees_16.ent";
-	case 0xc5af922f: return "trees_4.ent";
-	// .spn objects: entity/ambient_fx.objlib
-	case 0x1e7bd174: return "speed_streaks_short.ent";
-	case 0x87cdcba8: return "speed_streaks_RGB.ent";
-	case 0xc66f96dd: return "smoke.ent";
-	case 0xd7843636: return "death_shatter.ent";
-	case 0x55a80a99: return "speed_streaks.ent";
-	case 0x76414bb7: return "data_streaks_radial.ent";
-	case 0x49113923: return "boss_7_tunnel_enter.ent";
-	case 0xdb619bed: return "boss_damage_stage4.ent";
-	case 0xa28811db: return "crakhed_damage.ent";
-	case 0x6f02512b: return "win_debris.ent";
-	case 0xa8bd36c8: return "crakhed_destroy.ent";
-	case 0x71dc045d: return "stalactites.ent";
-	case 0x6ac944d0: return "aurora.ent";
-	case 0x01a07bd9: return "vortex_decorator.ent";
-	case 0x718ff746: return "boss_damage_stage3.ent";
-	case 0xd8258d1a: return "boss_damage_stage1.ent";
-	case 0xb00a87d0: return "boss_damage_stage2.ent";
-	// skybox_colors.flow (levels/demo.objlib)
-	case 0xd8e402da: return "black";
-	case 0x1411f1a3: return "crakhed";
-	case 0x4bb91040: return "dark_blue";
-	case 0xfa50813b: return "dark_green";
-	case 0x30656178: return "dark_red";
-	case 0xc0c8325a: return "light_blue";
-	case 0x3b652d19: return "light_green";
-	case 0xa7aa53f0: return "light_red";
-
-	// --- SFX objects ---
-
-	// 	turn_anticipation.flow (levels/Level6/level_6.objlib)
-	case 0xe5745bf3: return "fire";
-	// dissonant_bursts.flow (global/dissonant_bursts.objlib)
-	case 0xe073575f: return "diss11";
-	// french_horn_chords.flow (global/french_horn_chords.objlib)
-	case 0x79603dd3: return "french12";
-
-	// --- Bosses (.gate objects only) ---
-
-	// 	.spn objects: boss/gate_triangle/triangle_boss.objlib
-	case 0x8c0dd639: return "tutorial_thumps.ent";
-	// .spn objects: boss/boss_spiral/gate_spiral.objlib
-	case 0xc7c056e2: return "boss_gate_pellet.ent";
-	default: return nullptr;
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <system_error>
+
+namespace {
+	constexpr uint32_t kMagic = 0x48534841; // "AHSH"
+	constexpr uint32_t kVersion = 1;
+
+	// Image layout: Header, int32_t seeds[bucketCount], Slot slots[count], char names[nameBytes]
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t salt;
+		uint32_t count;
+		uint32_t bucketCount;
+		uint32_t nameBytes;
+	};
+
+	struct Slot {
+		uint32_t hash;
+		uint32_t name;
+	};
+
+	// Murmur3 finalizer, hash32 values are already well mixed but every seed has to give an unrelated placement
+	uint32_t mix(uint32_t key, uint32_t seed) {
+		uint32_t h = key ^ seed;
+		h ^= h >> 16;
+		h *= 0x85ebca6b;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35;
+		h ^= h >> 16;
+		return h;
+	}
+
+	// Maps a 32 bit value onto [0, range) without a division
+	uint32_t reduce(uint32_t value, uint32_t range) {
+		return static_cast<uint32_t>((static_cast<uint64_t>(value) * range) >> 32);
+	}
+
+	uint32_t bucket_of(uint32_t hash, uint32_t salt, uint32_t bucketCount) {
+		return reduce(mix(hash, salt), bucketCount);
+	}
+
+	// Negative seeds store the slot directly, positive seeds displace every key of the bucket together
+	uint32_t slot_of(uint32_t hash, uint32_t salt, int32_t seed, uint32_t count) {
+		if (seed < 0) return static_cast<uint32_t>(-(seed + 1));
+		return reduce(mix(hash, salt ^ (static_cast<uint32_t>(seed) * 0x9e3779b9)), count);
+	}
+
+	// Names found so far, new ones go into hashes.txt and need no rebuild
+	constexpr std::string_view kBuiltinNames[] = {
+		// --- undocumented ---
+		"AnimComp",
+		"EditStateComp",
+		"XfmComp",
+
+		// --- object parameters ---
+
+		// .lvl objects
+		"layer_volume",
+		// .leaf objects
+		"pitch",
+		"roll",
+		"turn",
+		"turn_auto",
+		"scale_x",
+		"scale_y",
+		"scale_z",
+		"offset_x",
+		"offset_y",
+		"offset_z",
+		"visibla01",
+		"visibla02",
+		"visible",
+		"visiblz01",
+		"visiblz02",
+		// avatar .objlib objects
+		"sequin_speed",
+		"win",
+		"win_checkpoint",
+		"win_checkpoint_silent",
+		// .samp objects
+		"play",
+		"play_clean",
+		"pause",
+		"resume",
+		"stop",
+		// .mat objects
+		"emissive_color",
+		"ambient_color",
+		"diffuse_color",
+		"specular_color",
+		"reflectivity_color",
+		"alpha",
+		// .anim objects
+		"frame",
+
+		// --- interactive player objects ---
+
+		// .spn objects: decorators/thump_rails.objlib
+		"thump_rails.a01",
+		"thump_rails.a02",
+		"thump_rails.ent",
+		"thump_rails.z01",
+		"thump_rails.z02",
+		"thump_checkpoint.ent",
+		"thump_rails_fast_activat.ent",
+		"thump_boss_bonus.ent",
+		// .spn objects: decorators/thump_grindable.objlib
+		"grindable_still.ent",
+		"left_multi.a01",
+		"left_multi.a02",
+		"left_multi.ent",
+		"left_multi.z01",
+		"center_multi.a02",
+		"center_multi.ent",
+		"center_multi.z01",
+		"right_multi.a02",
+		"right_multi.ent",
+		"right_multi.z01",
+		"right_multi.z02",
+		// .spn objects : decorators / thump_grindable_multi.objlib
+		"grindable_quarters.ent",
+		"grindable_double.ent",
+		"grindable_thirds.ent",
+		"grindable_with_thump.ent",
+		// 	.spn objects: decorators/ducker.objlib
+		"ducker_crak.ent",
+		// .spn objects : decorators / jumper / jumper_set.objlib
+		"jumper_1_step.ent",
+		"jumper_boss.ent",
+		"jumper_6_step.ent",
+		// .spn objects: decorators/jump_high/jump_high_set.objlib
+		"jump_high.ent",
+		"jump_high_2.ent",
+		"jump_high_4.ent",
+		"jump_high_6.ent",
+		"jump_boss.ent",
+		// .spn objects : decorators / obstacles / wurms / millipede_half.objlib
+		"swerve_off.a01",
+		"swerve_off.a02",
+		"swerve_off.ent",
+		"swerve_off.z01",
+		"swerve_off.z02",
+		"millipede_half.a01",
+		"millipede_half.a02",
+		"millipede_half.ent",
+		"millipede_half.z01",
+		"millipede_half.z02",
+		"millipede_half_phrase.a01",
+		"millipede_half_phrase.a02",
+		"millipede_half_phrase.ent",
+		"millipede_half_phrase.z01",
+		"millipede_half_phrase.z02",
+		// .spn objects: decorators/obstacles/wurms/millipede_quarter.objlib
+		"millipede_quarter.a01",
+		"millipede_quarter.a02",
+		"millipede_quarter.ent",
+		"millipede_quarter.z01",
+		"millipede_quarter.z02",
+		"millipede_quarter_phrase.a01",
+		"millipede_quarter_phrase.a02",
+		"millipede_quarter_phrase.ent",
+		"millipede_quarter_phrase.z01",
+		"millipede_quarter_phrase.z02",
+		// .spn objects: decorators/sentry.objlib
+		"sentry.ent",
+		"level_9.ent",
+		"level_5.ent",
+		"level_8.ent",
+		"sentry_boss.ent",
+		"level_7.ent",
+		"level_6.ent",
+		"sentry_boss_multilane.ent",
+		"level_8_multi.ent",
+		"level_9_multi.ent",
+
+		// --- decorative objects ---
+
+		// .spn objects: decorators/jump_high/jump_high_big_trees_set.objlib
+		"trees.ent",
+		"trees_16.ent",
+		"trees_4.ent",
+		// .spn objects: entity/ambient_fx.objlib
+		"speed_streaks_short.ent",
+		"speed_streaks_RGB.ent",
+		"smoke.ent",
+		"death_shatter.ent",
+		"speed_streaks.ent",
+		"data_streaks_radial.ent",
+		"boss_7_tunnel_enter.ent",
+		"boss_damage_stage4.ent",
+		"crakhed_damage.ent",
+		"win_debris.ent",
+		"crakhed_destroy.ent",
+		"stalactites.ent",
+		"aurora.ent",
+		"vortex_decorator.ent",
+		"boss_damage_stage3.ent",
+		"boss_damage_stage1.ent",
+		"boss_damage_stage2.ent",
+		// skybox_colors.flow (levels/demo.objlib)
+		"black",
+		"crakhed",
+		"dark_blue",
+		"dark_green",
+		"dark_red",
+		"light_blue",
+		"light_green",
+		"light_red",
+
+		// --- SFX objects ---
+
+		// 	turn_anticipation.flow (levels/Level6/level_6.objlib)
+		"fire",
+		// dissonant_bursts.flow (global/dissonant_bursts.objlib)
+		"diss11",
+		// french_horn_chords.flow (global/french_horn_chords.objlib)
+		"french12",
+
+		// --- Bosses (.gate objects only) ---
+
+		// 	.spn objects: boss/gate_triangle/triangle_boss.objlib
+		"tutorial_thumps.ent",
+		// .spn objects: boss/boss_spiral/gate_spiral.objlib
+		"boss_gate_pellet.ent",
+	};
+
+	template <class T>
+	T read_at(char const* ptr) {
+		T value;
+		memcpy(&value, ptr, sizeof(T));
+		return value;
+	}
+}
+
+uint32_t aurora::hash32(std::string_view text) {
+	uint32_t h = 0x811c9dc5;
+
+	for (char c : text)
+		h = (h ^ static_cast<unsigned char>(c)) * 0x1000193;
+
+	h *= 0x2001;
+	h = (h ^ (h >> 0x7)) * 0x9;
+	h = (h ^ (h >> 0x11)) * 0x21;
+
+	return h;
+}
+
+std::span<std::string_view const> aurora::builtin_hash_names() {
+	return kBuiltinNames;
+}
+
+aurora::HashDictionary aurora::HashDictionary::load(std::filesystem::path const& path) {
+	HashDictionary dictionary;
+
+	auto file = MappedFile::open(path);
+	if (!file) return dictionary;
+
+	if (dictionary.bind(file->data(), file->size()))
+		dictionary.mFile = std::move(file.value());
+
+	return dictionary;
+}
+
+bool aurora::HashDictionary::bind(char const* image, size_t size) {
+	if (size < sizeof(Header)) return false;
+
+	Header header = read_at<Header>(image);
+	if (header.magic != kMagic || header.version != kVersion) return false;
+	if (header.count != 0 && header.bucketCount == 0) return false;
+
+	uint64_t expected = sizeof(Header) + uint64_t(header.bucketCount) * sizeof(int32_t) + uint64_t(header.count) * sizeof(Slot) + header.nameBytes;
+	if (expected != size) return false;
+
+	// Lookups check name offsets against this, every name is then terminated
+	if (header.nameBytes != 0 && image[size - 1] != '\0') return false;
+
+	mSalt = header.salt;
+	mCount = header.count;
+	mBucketCount = header.bucketCount;
+	mNameBytes = header.nameBytes;
+	mSeeds = image + sizeof(Header);
+	mSlots = mSeeds + size_t(mBucketCount) * sizeof(int32_t);
+	mNames = mSlots + size_t(mCount) * sizeof(Slot);
+	return true;
+}
+
+bool aurora::HashDictionary::save(std::filesystem::path const& path) const {
+	std::filesystem::path temporary = path;
+	temporary += ".tmp";
+
+	{
+		std::ofstream stream(temporary, std::ios::out | std::ios::binary);
+		if (!stream) return false;
+
+		if (mSeeds) {
+			stream.write(mSeeds - sizeof(Header), sizeof(Header) + size_t(mBucketCount) * sizeof(int32_t) + size_t(mCount) * sizeof(Slot) + mNameBytes);
+		}
+		else {
+			Header header{ kMagic, kVersion, 0, 0, 0, 0 };
+			stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		}
+
+		if (!stream) return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(temporary, path, ec);
+	return !ec;
+}
+
+bool aurora::HashDictionary::add(std::string_view name) {
+	uint32_t hash = hash32(name);
+	if (find(hash)) return false;
+
+	mPending.emplace(hash, name);
+	return true;
+}
+
+bool aurora::HashDictionary::add_file(std::filesystem::path const& path) {
+	std::ifstream stream(path);
+	if (!stream) return false;
+
+	std::string line;
+	while (std::getline(stream, line)) {
+		while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t'))
+			line.pop_back();
+
+		if (line.empty() || line.front() == '#') continue;
+		add(line);
+	}
+
+	return true;
+}
+
+void aurora::HashDictionary::build() {
+	struct Key {
+		uint32_t hash;
+		std::string_view name;
+	};
+
+	std::vector<Key> keys;
+	keys.reserve(size());
+
+	for (uint32_t i = 0; i < mCount; ++i) {
+		Slot slot = read_at<Slot>(mSlots + size_t(i) * sizeof(Slot));
+		keys.push_back({ slot.hash, mNames + slot.name });
 	}
+
+	for (auto const& [hash, name] : mPending)
+		keys.push_back({ hash, name });
+
+	// Keeps the image independent of unordered_map iteration order
+	std::sort(keys.begin(), keys.end(), [](Key const& a, Key const& b) { return a.hash < b.hash; });
+
+	uint32_t const count = static_cast<uint32_t>(keys.size());
+	uint32_t const bucketCount = std::max(1u, (count + 3) / 4); // Four keys per bucket on average
+	uint32_t nameBytes = 0;
+	for (Key const& key : keys)
+		nameBytes += static_cast<uint32_t>(key.name.size()) + 1;
+
+	std::vector<int32_t> seeds(bucketCount);
+	std::vector<Slot> slots(count);
+	uint32_t salt = 0;
+
+	// Hash and displace: the biggest buckets are placed first while the table is still empty, each looks for a seed
+	// that puts all of its keys into free slots. Single key buckets take the remaining slots directly
+	for (bool placed = count == 0; !placed; ++salt) {
+		std::vector<std::vector<uint32_t>> buckets(bucketCount);
+		for (uint32_t i = 0; i < count; ++i)
+			buckets[bucket_of(keys[i].hash, salt, bucketCount)].push_back(i);
+
+		std::vector<uint32_t> order(bucketCount);
+		for (uint32_t i = 0; i < bucketCount; ++i)
+			order[i] = i;
+
+		std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+		std::vector<bool> taken(count, false);
+		std::vector<uint32_t> candidate;
+		std::fill(seeds.begin(), seeds.end(), 0);
+		uint32_t nextFree = 0;
+		placed = true;
+
+		for (uint32_t bucket : order) {
+			std::vector<uint32_t> const& members = buckets[bucket];
+			if (members.empty()) break;
+
+			if (members.size() == 1) {
+				while (taken[nextFree]) ++nextFree;
+				taken[nextFree] = true;
+				slots[nextFree].hash = keys[members[0]].hash;
+				seeds[bucket] = -static_cast<int32_t>(nextFree) - 1;
+				continue;
+			}
+
+			bool found = false;
+			for (int32_t seed = 1; seed < (1 << 20) && !found; ++seed) {
+				candidate.clear();
+
+				for (uint32_t member : members) {
+					uint32_t slot = slot_of(keys[member].hash, salt, seed, count);
+					if (taken[slot] || std::find(candidate.begin(), candidate.end(), slot) != candidate.end()) break;
+					candidate.push_back(slot);
+				}
+
+				if (candidate.size() != members.size()) continue;
+
+				for (size_t i = 0; i < members.size(); ++i) {
+					taken[candidate[i]] = true;
+					slots[candidate[i]].hash = keys[members[i]].hash;
+				}
+
+				seeds[bucket] = seed;
+				found = true;
+			}
+
+			// Practically never happens, a different salt gives every bucket new members
+			if (!found) {
+				placed = false;
+				break;
+			}
+		}
+
+		if (placed) break;
+	}
+
+	// Names are laid out in slot order
+	std::vector<char> image(sizeof(Header) + size_t(bucketCount) * sizeof(int32_t) + size_t(count) * sizeof(Slot) + nameBytes);
+	char* seedsOut = image.data() + sizeof(Header);
+	char* slotsOut = seedsOut + size_t(bucketCount) * sizeof(int32_t);
+	char* namesOut = slotsOut + size_t(count) * sizeof(Slot);
+
+	uint32_t nameOffset = 0;
+	for (Slot& slot : slots) {
+		auto key = std::lower_bound(keys.begin(), keys.end(), slot.hash, [](Key const& key, uint32_t hash) { return key.hash < hash; });
+		memcpy(namesOut + nameOffset, key->name.data(), key->name.size());
+		namesOut[nameOffset + key->name.size()] = '\0';
+		slot.name = nameOffset;
+		nameOffset += static_cast<uint32_t>(key->name.size()) + 1;
+	}
+
+	Header header{ kMagic, kVersion, salt, count, bucketCount, nameBytes };
+	memcpy(image.data(), &header, sizeof(header));
+	memcpy(seedsOut, seeds.data(), seeds.size() * sizeof(int32_t));
+	if (!slots.empty()) memcpy(slotsOut, slots.data(), slots.size() * sizeof(Slot));
+
+	// Names are copied out of the old image and mPending above, only now can they go
+	mImage = std::move(image);
+	bind(mImage.data(), mImage.size());
+	mFile = {};
+	mPending.clear();
+}
+
+char const* aurora::HashDictionary::find(uint32_t hash) const {
+	if (mCount != 0) {
+		int32_t seed = read_at<int32_t>(mSeeds + size_t(bucket_of(hash, mSalt, mBucketCount)) * sizeof(int32_t));
+		uint32_t index = slot_of(hash, mSalt, seed, mCount);
+
+		// Damaged seeds only ever miss, they never read outside the image
+		if (index < mCount) {
+			Slot slot = read_at<Slot>(mSlots + size_t(index) * sizeof(Slot));
+			if (slot.hash == hash && slot.name < mNameBytes) return mNames + slot.name;
+		}
+	}
+
+	auto it = mPending.find(hash);
+	if (it != mPending.end()) return it->second.c_str();
+	return nullptr;
+}
+
+std::vector<std::string_view> aurora::HashDictionary::names() const {
+	std::vector<std::string_view> names;
+	names.reserve(size());
+
+	for (uint32_t i = 0; i < mCount; ++i) {
+		Slot slot = read_at<Slot>(mSlots + size_t(i) * sizeof(Slot));
+		if (slot.name < mNameBytes) names.push_back(mNames + slot.name);
+	}
+
+	for (auto const& [hash, name] : mPending)
+		names.push_back(name);
+
+	return names;
 }
\ No newline at end of file
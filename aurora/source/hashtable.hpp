@@ -1,5 +1,66 @@
+#pragma once
+
+#include "mapped_file.hpp"
+
 #include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace aurora {
-	char const* lookupHash(uint32_t hash);
+	// The hash the game uses for every name it stores as a number
+	uint32_t hash32(std::string_view text);
+
+	// Names known to the source, the dictionary starts out with these
+	std::span<std::string_view const> builtin_hash_names();
+
+	// Reverse lookup from hash32 values to the names they came from
+	// Built names sit in a minimal perfect hash, one probe per lookup no matter how many names are known. The table is saved
+	// as a flat image that loads by mapping it, names added afterwards stay pending until the next `build`
+	class HashDictionary final {
+	public:
+		// A missing, outdated or damaged file loads as empty
+		static HashDictionary load(std::filesystem::path const& path);
+
+		// Only built names are saved
+		bool save(std::filesystem::path const& path) const;
+
+		// Returns false if the hash already has a name, the first name added for a hash wins
+		bool add(std::string_view name);
+
+		// One name per line, lines starting with # are comments
+		// Returns false if the file couldn't be opened
+		bool add_file(std::filesystem::path const& path);
+
+		// Folds the pending names into the perfect hash
+		void build();
+
+		// Returns nullptr for unknown hashes
+		char const* find(uint32_t hash) const;
+
+		// Every known name, the views stay valid until the next `build`
+		std::vector<std::string_view> names() const;
+
+		size_t size() const { return mCount + mPending.size(); }
+		size_t pending() const { return mPending.size(); }
+	private:
+		bool bind(char const* image, size_t size);
+
+		// Backs the image pointers, either the mapped file or an image built in memory
+		MappedFile mFile;
+		std::vector<char> mImage;
+
+		uint32_t mSalt = 0;
+		uint32_t mCount = 0;
+		uint32_t mBucketCount = 0;
+		uint32_t mNameBytes = 0;
+		char const* mSeeds = nullptr; // int32_t per bucket
+		char const* mSlots = nullptr; // hash and name offset per slot
+		char const* mNames = nullptr; // Null terminated names
+
+		std::unordered_map<uint32_t, std::string> mPending;
+	};
 }
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "leaf.hpp"
+
+#include <algorithm>
+#include <format>
+
+namespace {
+	// Empty name, the five header words and the editor point count, bounds reservations by the bytes left
+	constexpr size_t kMinTraitSize = 4 + 5 * sizeof(uint32_t) + sizeof(uint32_t);
+
+	// Time and two strings, the smallest point there is
+	constexpr size_t kMinPointSize = sizeof(float) + 2 * sizeof(uint32_t);
+
+	using aurora::TraitCodec;
+	using aurora::TraitColumn;
+
+	// Float, Bool and Action are confirmed by the game files, the other sizes follow from their value types
+	// Types without a known layout stop decoding, Benchmark leaf decoding lists how often each one occurs
+	constexpr TraitCodec kTraitCodecs[] = {
+		{ "Int", TraitColumn::kInts, 1, 4 },
+		{ "Bool", TraitColumn::kBytes, 1, 1 },
+		{ "Float", TraitColumn::kFloats, 1, 4 },
+		{ "Color", TraitColumn::kFloats, 4, 16 },
+		{ "Obj", TraitColumn::kNone, 0, 0 },
+		{ "Vec3", TraitColumn::kFloats, 3, 12 },
+		{ "Path", TraitColumn::kNone, 0, 0 },
+		{ "Enum", TraitColumn::kInts, 1, 4 },
+		{ "Action", TraitColumn::kBytes, 1, 1 },
+		{ "ObjVec", TraitColumn::kNone, 0, 0 },
+		{ "String", TraitColumn::kNone, 0, 0 },
+		{ "Cue", TraitColumn::kNone, 0, 0 },
+		{ "Event", TraitColumn::kNone, 0, 0 },
+		{ "Sym", TraitColumn::kNone, 0, 0 },
+		{ "List", TraitColumn::kNone, 0, 0 },
+		{ "TraitPath", TraitColumn::kNone, 0, 0 },
+		{ "Quat", TraitColumn::kFloats, 4, 16 },
+		{ "ChildLib", TraitColumn::kNone, 0, 0 },
+		{ "Component", TraitColumn::kNone, 0, 0 },
+	};
+
+	static_assert(std::size(kTraitCodecs) == static_cast<size_t>(TraitType::kNumTraitTypes));
+
+	// Values are copied into their column as raw bytes, the sizes have to agree with the column types
+	constexpr bool codecs_consistent() {
+		for (TraitCodec const& codec : kTraitCodecs) {
+			size_t element = 0;
+			switch (codec.column) {
+			case TraitColumn::kFloats: element = sizeof(float); break;
+			case TraitColumn::kInts: element = sizeof(int32_t); break;
+			case TraitColumn::kBytes: element = sizeof(uint8_t); break;
+			default: break;
+			}
+			if (codec.size != codec.components * element) return false;
+		}
+		return true;
+	}
+
+	static_assert(codecs_consistent());
+
+	constexpr TraitCodec kUnknownCodec = { "?", TraitColumn::kNone, 0, 0 };
+
+	// Appends `count` values straight from a record that was already validated
+	template <class T>
+	void read_values(aurora::BinaryCursor::Record& record, std::vector<T>& column, size_t count) {
+		size_t at = column.size();
+		column.resize(at + count);
+		record.bytes(column.data() + at, count * sizeof(T));
+	}
+}
+
+aurora::UnknownTraitType::UnknownTraitType(TraitType type)
+	: std::runtime_error(std::format("Unknown datapoint layout of trait type {} ({})", trait_codec(type).name, static_cast<uint32_t>(type))), mType(type) {
+}
+
+TraitCodec const& aurora::trait_codec(TraitType type) {
+	size_t index = static_cast<size_t>(type);
+	return index < std::size(kTraitCodecs) ? kTraitCodecs[index] : kUnknownCodec;
+}
+
+void aurora::Leaf::Trait::deserialize(BinaryCursor& cursor, Leaf& leaf) {
+	name = cursor.read_string();
+
+	auto head = cursor.record(5 * sizeof(uint32_t));
+	unknown0 = head.u32();
+	param = head.u32();
+	subobjectIdentifier = head.u32();
+	traitType = static_cast<TraitType>(head.u32());
+	uint32_t datapointCount = head.u32();
+
+	// One table lookup per trait, the loop below only copies fixed size values
+	TraitCodec const& codec = trait_codec(traitType);
+	if (codec.column == TraitColumn::kNone && datapointCount != 0)
+		throw UnknownTraitType(traitType);
+
+	times.clear();
+	floats.clear();
+	ints.clear();
+	bytes.clear();
+	interpolations.clear();
+	easings.clear();
+
+	size_t reserved = std::min<size_t>(datapointCount, cursor.remaining() / (kMinPointSize + codec.size));
+	times.reserve(reserved);
+	interpolations.reserve(reserved);
+	easings.reserve(reserved);
+
+	switch (codec.column) {
+	case TraitColumn::kFloats: floats.reserve(reserved * codec.components); break;
+	case TraitColumn::kInts: ints.reserve(reserved * codec.components); break;
+	case TraitColumn::kBytes: bytes.reserve(reserved * codec.components); break;
+	default: break;
+	}
+
+	for (uint32_t i = 0; i < datapointCount; ++i) {
+		auto point = cursor.record(sizeof(float) + codec.size);
+		times.push_back(point.f32());
+
+		switch (codec.column) {
+		case TraitColumn::kFloats: read_values(point, floats, codec.components); break;
+		case TraitColumn::kInts: read_values(point, ints, codec.components); break;
+		case TraitColumn::kBytes: read_values(point, bytes, codec.components); break;
+		default: break;
+		}
+
+		interpolations.push_back(leaf.intern(cursor.read_string_view()));
+		easings.push_back(leaf.intern(cursor.read_string_view()));
+	}
+
+	uint32_t editorPointCount = cursor.read_u32();
+	editorPoints.clear();
+	editorPoints.reserve(std::min<size_t>(editorPointCount, cursor.remaining() / kMinPointSize));
+	for (uint32_t i = 0; i < editorPointCount; ++i) {
+		EditorPoint& point = editorPoints.emplace_back();
+		auto values = cursor.record(2 * sizeof(float));
+		point.time = values.f32();
+		point.value = values.f32();
+		point.interpolation = cursor.read_string();
+		point.easing = cursor.read_string();
+	}
+
+	auto unknowns = cursor.record(sizeof(unknown1));
+	unknowns.bytes(unknown1, sizeof(unknown1));
+	intensityA = cursor.read_string();
+	intensityB = cursor.read_string();
+
+	auto tail = cursor.record(sizeof(unknown2) + sizeof(unknown3) + sizeof(unknown4) + sizeof(unknown5));
+	tail.bytes(unknown2, sizeof(unknown2));
+	unknown3 = tail.u32();
+	tail.bytes(unknown4, sizeof(unknown4));
+	tail.bytes(unknown5, sizeof(unknown5));
+}
+
+size_t aurora::Leaf::Trait::serialized_size(Leaf const& leaf) const {
+	size_t size = BinaryWriter::string_size(name) + 5 * sizeof(uint32_t);
+
+	size += datapoint_count() * (sizeof(float) + trait_codec(traitType).size);
+	for (size_t i = 0; i < datapoint_count(); ++i)
+		size += BinaryWriter::string_size(leaf.symbols[interpolations[i]]) + BinaryWriter::string_size(leaf.symbols[easings[i]]);
+
+	size += sizeof(uint32_t);
+	for (EditorPoint const& point : editorPoints)
+		size += 2 * sizeof(float) + BinaryWriter::string_size(point.interpolation) + BinaryWriter::string_size(point.easing);
+
+	return size + sizeof(unknown1)
+		+ BinaryWriter::string_size(intensityA)
+		+ BinaryWriter::string_size(intensityB)
+		+ sizeof(unknown2) + sizeof(unknown3) + sizeof(unknown4) + sizeof(unknown5);
+}
+
+void aurora::Leaf::Trait::serialize(BinaryWriter& writer, Leaf const& leaf) const {
+	writer.write_string(name);
+	writer.write_u32(unknown0);
+	writer.write_u32(param);
+	writer.write_u32(subobjectIdentifier);
+	writer.write_u32(static_cast<uint32_t>(traitType));
+	writer.write_u32(static_cast<uint32_t>(datapoint_count()));
+
+	TraitCodec const& codec = trait_codec(traitType);
+
+	for (size_t i = 0; i < datapoint_count(); ++i) {
+		writer.write_f32(times[i]);
+
+		switch (codec.column) {
+		case TraitColumn::kFloats: writer.write_bytes(floats.data() + i * codec.components, codec.size); break;
+		case TraitColumn::kInts: writer.write_bytes(ints.data() + i * codec.components, codec.size); break;
+		case TraitColumn::kBytes: writer.write_bytes(bytes.data() + i * codec.components, codec.size); break;
+		default: break;
+		}
+
+		writer.write_string(leaf.symbols[interpolations[i]]);
+		writer.write_string(leaf.symbols[easings[i]]);
+	}
+
+	writer.write_u32(static_cast<uint32_t>(editorPoints.size()));
+	for (EditorPoint const& point : editorPoints) {
+		writer.write_f32(point.time);
+		writer.write_f32(point.value);
+		writer.write_string(point.interpolation);
+		writer.write_string(point.easing);
+	}
+
+	writer.write_bytes(unknown1, sizeof(unknown1));
+	writer.write_string(intensityA);
+	writer.write_string(intensityB);
+	writer.write_bytes(unknown2, sizeof(unknown2));
+	writer.write_u32(unknown3);
+	writer.write_bytes(unknown4, sizeof(unknown4));
+	writer.write_bytes(unknown5, sizeof(unknown5));
+}
+
+uint16_t aurora::Leaf::intern(std::string_view symbol) {
+	for (size_t i = 0; i < symbols.size(); ++i)
+		if (symbols[i] == symbol) return static_cast<uint16_t>(i);
+
+	if (symbols.size() > UINT16_MAX) throw TruncatedData("Too many distinct interpolation names");
+	symbols.emplace_back(symbol);
+	return static_cast<uint16_t>(symbols.size() - 1);
+}
+
+void aurora::Leaf::deserialize(BinaryCursor& cursor) {
+	auto head = cursor.record(sizeof(header) + 3 * sizeof(uint32_t));
+	head.bytes(header, sizeof(header));
+	hash0 = head.u32();
+	unknown0 = head.u32();
+	unknown1 = head.f32();
+	timeUnit = cursor.read_string();
+
+	auto counts = cursor.record(2 * sizeof(uint32_t));
+	hash1 = counts.u32();
+	traitCount = counts.u32();
+
+	traits.clear();
+	symbols.clear();
+	traits.reserve(std::min<size_t>(traitCount, cursor.remaining() / kMinTraitSize));
+
+	for (uint32_t i = 0; i < traitCount; ++i) {
+		Trait trait;
+		trait.deserialize(cursor, *this);
+		traits.push_back(std::move(trait));
+	}
+}
+
+size_t aurora::Leaf::serialized_size() const {
+	size_t size = sizeof(header) + 3 * sizeof(uint32_t) + BinaryWriter::string_size(timeUnit) + 2 * sizeof(uint32_t);
+	for (Trait const& trait : traits)
+		size += trait.serialized_size(*this);
+	return size;
+}
+
+std::vector<uint8_t> aurora::Leaf::serialize() const {
+	std::vector<uint8_t> data(serialized_size());
+	BinaryWriter writer(std::as_writable_bytes(std::span(data)));
+
+	writer.write_bytes(header, sizeof(header));
+	writer.write_u32(hash0);
+	writer.write_u32(unknown0);
+	writer.write_f32(unknown1);
+	writer.write_string(timeUnit);
+	writer.write_u32(hash1);
+	writer.write_u32(static_cast<uint32_t>(traits.size()));
+
+	for (Trait const& trait : traits)
+		trait.serialize(writer, *this);
+
+	return data;
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "binary_cursor.hpp"
+#include "binary_writer.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum struct TraitType : uint32_t {
+	kTraitInt = 0,
+	kTraitBool,
+	kTraitFloat,
+	kTraitColor,
+	kTraitObj,
+	kTraitVec3,
+	kTraitPath,
+	kTraitEnum,
+	kTraitAction,
+	kTraitObjVec,
+	kTraitString,
+	kTraitCue,
+	kTraitEvent,
+	kTraitSym,
+	kTraitList,
+	kTraitTraitPath,
+	kTraitQuat,
+	kTraitChildLib,
+	kTraitComponent,
+
+	kNumTraitTypes,
+};
+
+namespace aurora {
+	// Column of Leaf::Trait a trait type keeps its datapoint values in
+	enum struct TraitColumn : uint8_t {
+		kNone, // Layout unknown, the trait can't be decoded
+		kFloats,
+		kInts,
+		kBytes,
+	};
+
+	// On disk layout of the value of one datapoint
+	// Values are stored as they are on disk, a fixed number of little endian components per datapoint
+	struct TraitCodec {
+		char const* name;
+		TraitColumn column;
+		uint8_t components; // Per datapoint
+		uint8_t size; // Bytes per datapoint, 0 when the layout isn't known
+	};
+
+	// Indexed by TraitType, types outside the enum get an unknown layout
+	TraitCodec const& trait_codec(TraitType type);
+
+	// Thrown for a trait whose datapoint layout isn't known, nothing after it can be located
+	class UnknownTraitType final : public std::runtime_error {
+	public:
+		explicit UnknownTraitType(TraitType type);
+		TraitType type() const { return mType; }
+	private:
+		TraitType mType;
+	};
+
+	// A Leaf record decoded in one pass, independent of any UI
+	struct Leaf final {
+		// Points Drool's editor displays, the last value is unused
+		struct EditorPoint {
+			float time;
+			float value;
+			std::string interpolation;
+			std::string easing;
+		};
+
+		struct Trait {
+			std::string name;
+			uint32_t unknown0;
+			uint32_t param; // Hash
+			uint32_t subobjectIdentifier;
+			TraitType traitType;
+
+			// Datapoints as parallel columns, entry i of every column belongs to datapoint i
+			// Only the value column of the trait type's codec is filled, with `components` entries per datapoint
+			std::vector<float> times;
+			std::vector<float> floats;
+			std::vector<int32_t> ints;
+			std::vector<uint8_t> bytes;
+			std::vector<uint16_t> interpolations; // Into Leaf::symbols
+			std::vector<uint16_t> easings; // Into Leaf::symbols
+
+			std::vector<EditorPoint> editorPoints;
+
+			uint32_t unknown1[5];
+			std::string intensityA;
+			std::string intensityB;
+			uint8_t unknown2[2];
+			uint32_t unknown3;
+			float unknown4[5];
+			uint8_t unknown5[3];
+
+			size_t datapoint_count() const { return times.size(); }
+
+			void deserialize(BinaryCursor& cursor, Leaf& leaf);
+			size_t serialized_size(Leaf const& leaf) const;
+			void serialize(BinaryWriter& writer, Leaf const& leaf) const;
+		};
+
+		uint32_t header[4];
+		uint32_t hash0;
+		uint32_t unknown0;
+		float unknown1;
+		std::string timeUnit;
+		uint32_t hash1;
+		uint32_t traitCount; // As stored, `traits` is shorter when decoding stopped early
+		std::vector<Trait> traits;
+
+		// Interpolation and easing names of every datapoint, a leaf only uses a handful
+		std::vector<std::string> symbols;
+		uint16_t intern(std::string_view symbol);
+
+		// Throws TruncatedData or UnknownTraitType, the traits decoded up to that point are kept
+		void deserialize(BinaryCursor& cursor);
+
+		// Writes the decoded traits, a leaf that decoded completely comes out byte for byte as it was read
+		size_t serialized_size() const;
+		std::vector<uint8_t> serialize() const;
+	};
+}
\ No newline at end of file
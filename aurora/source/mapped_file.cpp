@@ -0,0 +1,99 @@
+#include "mapped_file.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+std::optional<aurora::MappedFile> aurora::MappedFile::open(std::filesystem::path const& path) {
+	MappedFile file;
+
+#ifdef _WIN32
+	HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) return std::nullopt;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(handle, &size)) {
+		CloseHandle(handle);
+		return std::nullopt;
+	}
+
+	// Zero length files cannot be mapped, they are still valid files though
+	if (size.QuadPart == 0) {
+		CloseHandle(handle);
+		return file;
+	}
+
+	HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(handle);
+	if (!mapping) return std::nullopt;
+
+	// The view keeps the mapping alive, both handles can be closed right away
+	void* address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!address) return std::nullopt;
+
+	file.mAddress = address;
+	file.mSize = static_cast<size_t>(size.QuadPart);
+#else
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1) return std::nullopt;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		::close(fd);
+		return std::nullopt;
+	}
+
+	if (info.st_size == 0) {
+		::close(fd);
+		return file;
+	}
+
+	void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (address == MAP_FAILED) return std::nullopt;
+
+	file.mAddress = address;
+	file.mSize = static_cast<size_t>(info.st_size);
+#endif
+
+	return file;
+}
+
+aurora::MappedFile::MappedFile(MappedFile&& other) noexcept
+	: mAddress(std::exchange(other.mAddress, nullptr)), mSize(std::exchange(other.mSize, 0)) {
+}
+
+aurora::MappedFile& aurora::MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this != &other) {
+		release();
+		mAddress = std::exchange(other.mAddress, nullptr);
+		mSize = std::exchange(other.mSize, 0);
+	}
+
+	return *this;
+}
+
+aurora::MappedFile::~MappedFile() {
+	release();
+}
+
+void aurora::MappedFile::release() {
+	if (!mAddress) return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(mAddress);
+#else
+	munmap(mAddress, mSize);
+#endif
+
+	mAddress = nullptr;
+	mSize = 0;
+}
\ No newline at end of file
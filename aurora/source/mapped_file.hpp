@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace aurora {
+	// Read only view of a whole file, backed by the OS page cache instead of a heap copy
+	class MappedFile final {
+	public:
+		static std::optional<MappedFile> open(std::filesystem::path const& path);
+
+		MappedFile() = default;
+		MappedFile(MappedFile const&) = delete;
+		MappedFile& operator=(MappedFile const&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		~MappedFile();
+
+		std::span<std::byte const> bytes() const { return { static_cast<std::byte const*>(mAddress), mSize }; }
+		char const* data() const { return static_cast<char const*>(mAddress); }
+		size_t size() const { return mSize; }
+	private:
+		void release();
+
+		void* mAddress = nullptr;
+		size_t mSize = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "murmur3.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace {
+	constexpr uint64_t kC1 = 0x87c37b91114253d5ull;
+	constexpr uint64_t kC2 = 0x4cf5ad432745937full;
+
+	uint64_t fmix64(uint64_t k) {
+		k ^= k >> 33;
+		k *= 0xff51afd7ed558ccdull;
+		k ^= k >> 33;
+		k *= 0xc4ceb9fe1a85ec53ull;
+		k ^= k >> 33;
+		return k;
+	}
+
+	uint64_t load64(std::byte const* ptr) {
+		uint64_t value;
+		memcpy(&value, ptr, sizeof(value));
+		return value;
+	}
+}
+
+aurora::Hash128 aurora::murmur3_128(std::span<std::byte const> data, uint32_t seed) {
+	size_t const blockCount = data.size() / 16;
+	uint64_t h1 = seed;
+	uint64_t h2 = seed;
+
+	for (size_t i = 0; i < blockCount; ++i) {
+		uint64_t k1 = load64(data.data() + i * 16);
+		uint64_t k2 = load64(data.data() + i * 16 + 8);
+
+		k1 *= kC1; k1 = std::rotl(k1, 31); k1 *= kC2; h1 ^= k1;
+		h1 = std::rotl(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+		k2 *= kC2; k2 = std::rotl(k2, 33); k2 *= kC1; h2 ^= k2;
+		h2 = std::rotl(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+	}
+
+	std::byte const* tail = data.data() + blockCount * 16;
+	uint64_t k1 = 0;
+	uint64_t k2 = 0;
+
+	switch (data.size() & 15) {
+	case 15: k2 ^= static_cast<uint64_t>(tail[14]) << 48; [[fallthrough]];
+	case 14: k2 ^= static_cast<uint64_t>(tail[13]) << 40; [[fallthrough]];
+	case 13: k2 ^= static_cast<uint64_t>(tail[12]) << 32; [[fallthrough]];
+	case 12: k2 ^= static_cast<uint64_t>(tail[11]) << 24; [[fallthrough]];
+	case 11: k2 ^= static_cast<uint64_t>(tail[10]) << 16; [[fallthrough]];
+	case 10: k2 ^= static_cast<uint64_t>(tail[9]) << 8; [[fallthrough]];
+	case 9:
+		k2 ^= static_cast<uint64_t>(tail[8]);
+		k2 *= kC2; k2 = std::rotl(k2, 33); k2 *= kC1; h2 ^= k2;
+		[[fallthrough]];
+	case 8: k1 ^= static_cast<uint64_t>(tail[7]) << 56; [[fallthrough]];
+	case 7: k1 ^= static_cast<uint64_t>(tail[6]) << 48; [[fallthrough]];
+	case 6: k1 ^= static_cast<uint64_t>(tail[5]) << 40; [[fallthrough]];
+	case 5: k1 ^= static_cast<uint64_t>(tail[4]) << 32; [[fallthrough]];
+	case 4: k1 ^= static_cast<uint64_t>(tail[3]) << 24; [[fallthrough]];
+	case 3: k1 ^= static_cast<uint64_t>(tail[2]) << 16; [[fallthrough]];
+	case 2: k1 ^= static_cast<uint64_t>(tail[1]) << 8; [[fallthrough]];
+	case 1:
+		k1 ^= static_cast<uint64_t>(tail[0]);
+		k1 *= kC1; k1 = std::rotl(k1, 31); k1 *= kC2; h1 ^= k1;
+	}
+
+	h1 ^= data.size();
+	h2 ^= data.size();
+
+	h1 += h2;
+	h2 += h1;
+
+	h1 = fmix64(h1);
+	h2 = fmix64(h2);
+
+	h1 += h2;
+	h2 += h1;
+
+	return { h1, h2 };
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace aurora {
+	struct Hash128 {
+		uint64_t low;
+		uint64_t high;
+
+		bool operator==(Hash128 const&) const = default;
+	};
+
+	// MurmurHash3 x64 128, used where a hash has to identify content rather than just spread keys
+	Hash128 murmur3_128(std::span<std::byte const> data, uint32_t seed = 0);
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "objlib.hpp"
+
+#include "binary_cursor.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Leading bytes of the definitions we can find, the same headers the byte search window offers
+	struct DefinitionSignature {
+		ObjType type;
+		uint8_t bytes[16];
+		size_t size;
+	};
+
+	constexpr DefinitionSignature kSignatures[] = {
+		{ ObjType::kSamp,   { 0x0C, 0, 0, 0, 0x04, 0, 0, 0, 0x01, 0, 0, 0 }, 12 },
+		{ ObjType::kSpn,    { 0x01, 0, 0, 0, 0x04, 0, 0, 0, 0x02, 0, 0, 0 }, 12 },
+		{ ObjType::kMaster, { 0x21, 0, 0, 0, 0x21, 0, 0, 0, 0x04, 0, 0, 0, 0x02, 0, 0, 0 }, 16 },
+		{ ObjType::kLeaf,   { 0x22, 0, 0, 0, 0x21, 0, 0, 0, 0x04, 0, 0, 0, 0x02, 0, 0, 0 }, 16 },
+	};
+
+	int signatureIndex(ObjType type) {
+		for (size_t i = 0; i < std::size(kSignatures); ++i)
+			if (kSignatures[i].type == type) return static_cast<int>(i);
+		return -1;
+	}
+}
+
+std::atomic_int failedCount = 0;
+
+ObjlibSupport checkObjlibHeader(ObjlibHeader const& header) {
+	if (header.fileType == FileType::kMeshX) return ObjlibSupport::kSkipped;
+	if (header.fileType != FileType::kObjlib) return ObjlibSupport::kFailed;
+	if (header.objType == ObjType::kObjlibObj) return ObjlibSupport::kFailed;
+	return ObjlibSupport::kSupported;
+}
+
+char const* objTypeName(ObjType type) {
+	switch (type) {
+	case ObjType::kAnim: return "Anim";
+	case ObjType::kBend: return "Bend";
+	case ObjType::kBind: return "Bind";
+	case ObjType::kCam: return "Cam";
+	case ObjType::kCh: return "Ch";
+	case ObjType::kCond: return "Cond";
+	case ObjType::kDch: return "Dch";
+	case ObjType::kDec: return "Dec";
+	case ObjType::kDsp: return "Dsp";
+	case ObjType::kEnt: return "Ent";
+	case ObjType::kEnv: return "Env";
+	case ObjType::kFlow: return "Flow";
+	case ObjType::kFlt_0: return "Flt";
+	case ObjType::kFlt_1: return "Flt";
+	case ObjType::kGameplay: return "Gameplay";
+	case ObjType::kGate: return "Gate";
+	case ObjType::kGrp: return "Grp";
+	case ObjType::kLeaf: return "Leaf";
+	case ObjType::kLight: return "Light";
+	case ObjType::kLvl: return "Lvl";
+	case ObjType::kMaster: return "Master";
+	case ObjType::kMastering: return "Mastering";
+	case ObjType::kMat: return "Mat";
+	case ObjType::kMesh: return "Mesh";
+	case ObjType::kObjlibGfx: return "ObjlibGfx";
+	case ObjType::kObjlibSequin: return "ObjlibSequin";
+	case ObjType::kObjlibObj: return "ObjlibObj";
+	case ObjType::kObjlibLevel: return "ObjlibLevel";
+	case ObjType::kObjlibAvatar: return "ObjlibAvatar";
+	case ObjType::kPath: return "Path";
+	case ObjType::kPlayspace: return "Playspace";
+	case ObjType::kPulse: return "Pulse";
+	case ObjType::kSamp: return "Samp";
+	case ObjType::kSDraw_Drawer: return "SDraw";
+	case ObjType::kSh: return "Sh";
+	case ObjType::kSpn: return "Spn";
+	case ObjType::kSt: return "St";
+	case ObjType::kSteer: return "Steer";
+	case ObjType::kTex: return "Tex";
+	case ObjType::kVib: return "Vib";
+	case ObjType::kVrSettings: return "VrSettings";
+	case ObjType::kXfm_Xfmer: return "Xfm";
+	}
+
+	return nullptr;
+}
+
+bool isIndexedObjType(ObjType type) {
+	return signatureIndex(type) != -1;
+}
+
+std::optional<Objlib> readObjlib(char const* file) {
+	auto raw = aurora::MappedFile::open(file);
+	if (!raw) return std::nullopt;
+	return parseObjlib(file, std::move(raw.value()));
+}
+
+std::optional<Objlib> parseObjlib(std::string originFile, aurora::MappedFile raw) {
+	Objlib lib;
+
+	lib.originFile = std::move(originFile);
+	lib.raw = std::move(raw);
+
+	try {
+		aurora::BinaryCursor cursor(lib.raw.bytes());
+
+		lib.header = cursor.read<ObjlibHeader>();
+
+		if (checkObjlibHeader(lib.header) != ObjlibSupport::kSupported) return std::nullopt;
+
+		if (lib.header.objType == ObjType::kObjlibGfx) {
+			// nothing here?
+		}
+
+		// Not very sure what this value is
+		if (lib.header.objType == ObjType::kObjlibLevel) cursor.skip(sizeof(uint32_t));
+
+		// Not very sure what this value is
+		if (lib.header.objType == ObjType::kObjlibAvatar) cursor.skip(sizeof(uint32_t));
+
+		// Not very sure what this value is
+		if (lib.header.objType == ObjType::kObjlibSequin) cursor.skip(sizeof(uint32_t));
+
+		// Counts are clamped to what could possibly fit in the file so a damaged count can't reserve gigabytes
+		uint32_t libraryImportCount = cursor.read_u32();
+		lib.libraryImports.reserve(std::min<size_t>(libraryImportCount, cursor.remaining() / 8));
+
+		for (uint32_t i = 0; i < libraryImportCount; ++i) {
+			LibraryImport o;
+			o.unknown0 = cursor.read_u32();
+			o.string = cursor.read_string_view();
+			lib.libraryImports.emplace_back(o);
+		}
+
+		lib.originalName = cursor.read_string_view();
+
+		uint32_t objectImportCount = cursor.read_u32();
+		lib.objectImports.reserve(std::min<size_t>(objectImportCount, cursor.remaining() / 16));
+
+		for (uint32_t i = 0; i < objectImportCount; ++i) {
+			ObjectImport o;
+			o.type = cursor.read<ObjType>();
+			o.objName = cursor.read_string_view();
+			o.unknown0 = cursor.read_u32();
+			o.libraryName = cursor.read_string_view();
+			lib.objectImports.push_back(o);
+		}
+
+		uint32_t objectCount = cursor.read_u32();
+		lib.objects.reserve(std::min<size_t>(objectCount, cursor.remaining() / 8));
+
+		for (uint32_t i = 0; i < objectCount; ++i) {
+			Object o;
+			o.type = cursor.read<ObjType>();
+			o.name = cursor.read_string_view();
+			lib.objects.push_back(o);
+		}
+
+		lib.headerDefOffset = cursor.offset();
+	}
+	catch (aurora::TruncatedData const&) {
+		return std::nullopt;
+	}
+
+	return lib;
+}
+
+void indexObjlibDefinitions(Objlib& lib) {
+	char const* const data = lib.raw.data();
+	size_t const size = lib.raw.size();
+	if (lib.headerDefOffset >= size || size > UINT32_MAX) return;
+
+	// One pass collects every possible start of every signature, positions come out sorted
+	std::vector<uint32_t> candidates[std::size(kSignatures)];
+	uint32_t leadingWords[std::size(kSignatures)];
+	for (size_t i = 0; i < std::size(kSignatures); ++i)
+		memcpy(&leadingWords[i], kSignatures[i].bytes, sizeof(uint32_t));
+
+	for (size_t offset = lib.headerDefOffset; offset + sizeof(uint32_t) <= size; ++offset) {
+		uint32_t word;
+		memcpy(&word, data + offset, sizeof(uint32_t));
+
+		for (size_t i = 0; i < std::size(kSignatures); ++i) {
+			if (word != leadingWords[i]) continue;
+			if (size - offset < kSignatures[i].size) continue;
+			if (memcmp(data + offset, kSignatures[i].bytes, kSignatures[i].size) != 0) continue;
+			candidates[i].push_back(static_cast<uint32_t>(offset));
+		}
+	}
+
+	// Definitions are stored in declaration order, so each declared object takes the first candidate
+	// of its type past the previous located definition. That skips signatures inside located records,
+	// but records of types we can't locate have no known size, a signature inside one of those can still be taken
+	size_t next[std::size(kSignatures)] = {};
+	size_t position = lib.headerDefOffset;
+	Object* previous = nullptr; // The object declared right before, located or not
+
+	for (Object& object : lib.objects) {
+		object.offset = 0;
+		object.length = 0;
+
+		int index = signatureIndex(object.type);
+		Object* const before = std::exchange(previous, &object);
+		if (index == -1) continue;
+
+		std::vector<uint32_t> const& list = candidates[index];
+		size_t& cursor = next[index];
+		while (cursor < list.size() && list[cursor] < position) ++cursor;
+		if (cursor == list.size()) continue;
+
+		object.offset = list[cursor++];
+		position = object.offset + kSignatures[index].size;
+
+		// Only a located neighbour bounds a definition, an unlocated one in between would be counted as part of it
+		if (before && before->offset != 0) before->length = object.offset - before->offset;
+	}
+}
\ No newline at end of file
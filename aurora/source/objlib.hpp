@@ -0,0 +1,133 @@
+#pragma once
+
+#include "mapped_file.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum struct FileType : uint32_t {
+	kMeshX      =  6,
+	kObjlib     =  8,
+	kFsbTexture = 13,
+	kDdsTexture = 14,
+};
+
+enum struct ObjType : uint32_t {
+	kAnim = 0x5232f8f9,
+	kBend = 0x7dd6b7d8,
+	kBind = 0x570e17fa,
+	kCam = 0x8f86650f,
+	kCh = 0xadb02913,
+	kCond = 0x4945e860,
+	kDch = 0xac1abb2c,
+	kDec = 0x9ce604da,
+	kDsp = 0xacc2033e,
+	kEnt = 0xeae6beee,
+	kEnv = 0x3bbcc4ec,
+	kFlow = 0x86621b1e,
+	kFlt_0 = 0x6222e06f,
+	kFlt_1 = 0x993811f5,
+	kGameplay = 0xc2fd0a11,
+	kGate = 0xaa63a508,
+	kGrp = 0xc2aaec43,
+	kLeaf = 0xce7e85f6,
+	kLight = 0x711a2715,
+	kLvl = 0xbcd17473,
+	kMaster = 0x490780b9,
+	kMastering = 0x1a5812f6,
+	kMat = 0x7ba5c8e0,
+	kMesh = 0xbf69f115,
+	kObjlibGfx = 0x1ba51443,
+	kObjlibSequin = 0xb0954548,
+	kObjlibObj = 0x9d1c6219,
+	kObjlibLevel = 0x0b374d9e,
+	kObjlibAvatar = 0xe674624f,
+	kPath = 0x4890a3f6,
+	kPlayspace = 0x745dd78b,
+	kPulse = 0x230da622,
+	kSamp = 0x7aa8f390,
+	kSDraw_Drawer = 0xd3058b5d,
+	kSh = 0xcac934cf,
+	kSpn = 0xd897d5db,
+	kSt = 0xd955fdc6,
+	kSteer = 0xe7b3aadb,
+	kTex = 0x96ba8a70,
+	kVib = 0x799c45a7,
+	kVrSettings = 0x4f37349d,
+	kXfm_Xfmer = 0x7d9db5ef
+};
+
+struct ObjlibHeader {
+	FileType fileType;
+	ObjType objType;
+	uint32_t unknown0;
+	uint32_t unknown1;
+	uint32_t unknown2;
+};
+
+// Names are views into Objlib::raw, they are never copied out of the mapping
+
+struct LibraryImport {
+	uint32_t unknown0;
+	std::string_view string;
+};
+
+struct ObjectImport {
+	ObjType type;
+	std::string_view objName;
+	uint32_t unknown0;
+	std::string_view libraryName;
+};
+
+struct Object {
+	ObjType type;
+	std::string_view name;
+
+	// Where the definition of this object starts in Objlib::raw, zero when it wasn't located
+	// The length runs up to the next declared object's definition, zero unless that one was located too.
+	// The last declared object's end is never known, decoders tell where their record ends
+	uint32_t offset = 0;
+	uint32_t length = 0;
+};
+
+struct Objlib {
+	std::string originFile;
+
+	aurora::MappedFile raw;
+	size_t headerDefOffset; // Offset into raw data the object definitions start
+
+	ObjlibHeader header;
+	std::string_view originalName;
+	std::vector<LibraryImport> libraryImports;
+	std::vector<ObjectImport> objectImports;
+	std::vector<Object> objects;
+};
+
+// How the scanner treats a .pc file based on its leading header
+enum struct ObjlibSupport {
+	kSupported,
+	kSkipped, // Not an objlib but a known type, e.g. meshes
+	kFailed,
+};
+
+ObjlibSupport checkObjlibHeader(ObjlibHeader const& header);
+
+// Short type name, e.g. "Samp", nullptr for values not in ObjType
+char const* objTypeName(ObjType type);
+
+// True for the object types `indexObjlibDefinitions` can locate
+bool isIndexedObjType(ObjType type);
+
+// Parses the header part of an objlib, returns std::nullopt if the file isn't a supported objlib or is truncated
+std::optional<Objlib> readObjlib(char const* file);
+std::optional<Objlib> parseObjlib(std::string originFile, aurora::MappedFile raw);
+
+// Locates the definitions of Samp, Spn, Master and Leaf objects in one pass over the region after headerDefOffset
+// Fills Object::offset and Object::length, any other type is left unlocated
+void indexObjlibDefinitions(Objlib& lib);
+
+extern std::atomic_int failedCount;
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "parallel.hpp"
+
+#include <algorithm>
+
+aurora::WorkerPool& aurora::WorkerPool::instance() {
+	static WorkerPool pool;
+	return pool;
+}
+
+aurora::WorkerPool::WorkerPool() {
+	unsigned count = worker_count() - 1;
+	mThreads.reserve(count);
+	for (unsigned i = 0; i < count; ++i)
+		mThreads.emplace_back(&WorkerPool::work, this);
+}
+
+aurora::WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard lock(mMutex);
+		mStopping = true;
+	}
+	mWork.notify_all();
+
+	for (auto& thread : mThreads)
+		thread.join();
+}
+
+void aurora::WorkerPool::execute(Job& job) {
+	{
+		std::lock_guard lock(mMutex);
+		mJobs.push_back(&job);
+	}
+	mWork.notify_all();
+
+	job.run(job.context, 0);
+
+	// Slot 0 finished every index, slots still queued aren't needed anymore
+	std::unique_lock lock(mMutex);
+	auto it = std::find(mJobs.begin(), mJobs.end(), &job);
+	if (it != mJobs.end()) mJobs.erase(it);
+	mDone.wait(lock, [&] { return job.active == 0; });
+}
+
+void aurora::WorkerPool::work() {
+	std::unique_lock lock(mMutex);
+
+	for (;;) {
+		mWork.wait(lock, [&] { return mStopping || !mJobs.empty(); });
+		if (mStopping) return;
+
+		Job& job = *mJobs.front();
+		unsigned slot = job.next++;
+		if (job.next == job.slots) mJobs.pop_front();
+		++job.active;
+
+		lock.unlock();
+		job.run(job.context, slot);
+		lock.lock();
+
+		if (--job.active == 0) mDone.notify_all();
+	}
+}
\ No newline at end of file
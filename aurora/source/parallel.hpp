@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aurora {
+	inline unsigned worker_count() {
+		return std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// worker_count() - 1 threads created on first use and kept until exit, every parallel_for runs on them
+	// The calling thread always works on its own job too, so a job finishes even when every pool thread is busy
+	// with another one. Nested calls and calls from other background threads never wait on a queued slot
+	class WorkerPool final {
+	public:
+		struct Job {
+			void (*run)(void* context, unsigned slot);
+			void* context;
+			unsigned slots; // Slot 0 belongs to the caller
+			unsigned next = 1; // Next slot handed to a pool thread, guarded by the pool mutex
+			unsigned active = 0; // Pool threads inside `run`, guarded by the pool mutex
+		};
+
+		static WorkerPool& instance();
+
+		WorkerPool(WorkerPool const&) = delete;
+		WorkerPool& operator=(WorkerPool const&) = delete;
+		~WorkerPool();
+
+		// Runs slot 0 on the calling thread and the others on whichever pool threads are idle
+		// Slots no pool thread picked up are never run, `job.run` must be able to finish the work from slot 0 alone
+		void execute(Job& job);
+	private:
+		WorkerPool();
+		void work();
+
+		std::mutex mMutex;
+		std::condition_variable mWork;
+		std::condition_variable mDone;
+		std::deque<Job*> mJobs; // Jobs with slots left to hand out
+		bool mStopping = false;
+		std::vector<std::thread> mThreads;
+	};
+
+	// Calls `fn(index, worker)` for every index in [0, count), `worker` is in [0, worker_count())
+	// Every worker starts with an even slice of the range, once its own slice runs dry it steals
+	// the upper half of another worker's remaining slice. This keeps all cores busy when item costs vary wildly
+	template <class Fn>
+	void parallel_for(size_t count, Fn&& fn) {
+		if (count == 0) return;
+
+		unsigned const workers = static_cast<unsigned>(std::min<size_t>(worker_count(), count));
+
+		struct alignas(64) Slice {
+			std::mutex mutex;
+			size_t begin = 0;
+			size_t end = 0;
+		};
+
+		std::unique_ptr<Slice[]> slices = std::make_unique<Slice[]>(workers);
+		for (unsigned i = 0; i < workers; ++i) {
+			slices[i].begin = count * i / workers;
+			slices[i].end = count * (i + 1) / workers;
+		}
+
+		auto run = [&](unsigned self) {
+			Slice& own = slices[self];
+
+			for (;;) {
+				size_t index = 0;
+				bool found = false;
+
+				{
+					std::lock_guard lock(own.mutex);
+					if (own.begin < own.end) {
+						index = own.begin++;
+						found = true;
+					}
+				}
+
+				if (found) {
+					fn(index, self);
+					continue;
+				}
+
+				// Steal, never hold two slice locks at once
+				bool stolen = false;
+				for (unsigned offset = 1; offset < workers && !stolen; ++offset) {
+					Slice& victim = slices[(self + offset) % workers];
+					size_t begin, end;
+
+					{
+						std::lock_guard lock(victim.mutex);
+						if (victim.begin >= victim.end) continue;
+						begin = victim.begin + (victim.end - victim.begin) / 2;
+						end = victim.end;
+						victim.end = begin;
+					}
+
+					std::lock_guard lock(own.mutex);
+					own.begin = begin;
+					own.end = end;
+					stolen = true;
+				}
+
+				if (!stolen) return;
+			}
+		};
+
+		if (workers == 1) {
+			run(0);
+			return;
+		}
+
+		WorkerPool::Job job{ [](void* context, unsigned slot) { (*static_cast<decltype(run)*>(context))(slot); }, &run, workers };
+		WorkerPool::instance().execute(job);
+	}
+}
\ No newline at end of file
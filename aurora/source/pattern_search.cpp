@@ -0,0 +1,102 @@
+#include "pattern_search.hpp"
+
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+std::optional<std::vector<std::byte>> aurora::parse_hex_pattern(std::string_view text) {
+	std::vector<std::byte> pattern;
+
+	while (!text.empty()) {
+		size_t begin = text.find_first_not_of(" \t\r");
+		if (begin == std::string_view::npos) break;
+		text.remove_prefix(begin);
+
+		size_t end = std::min(text.find_first_of(" \t\r"), text.size());
+		std::string_view token = text.substr(0, end);
+		text.remove_prefix(end);
+
+		unsigned value = 0;
+		auto [ptr, error] = std::from_chars(token.data(), token.data() + token.size(), value, 16);
+		if (error != std::errc() || ptr != token.data() + token.size() || value > 0xff) return std::nullopt;
+
+		pattern.push_back(static_cast<std::byte>(value));
+	}
+
+	if (pattern.empty()) return std::nullopt;
+	return pattern;
+}
+
+aurora::PatternSet::PatternSet(std::vector<std::vector<std::byte>> patterns) : mPatterns(std::move(patterns)) {
+	std::erase_if(mPatterns, [](std::vector<std::byte> const& pattern) { return pattern.empty(); });
+
+	for (auto const& pattern : mPatterns) {
+		Anchor anchor{ static_cast<uint8_t>(pattern.front()), static_cast<uint8_t>(pattern.back()), pattern.size() - 1 };
+		mLongest = std::max(mLongest, pattern.size());
+
+		bool known = std::any_of(mAnchors.begin(), mAnchors.end(), [&](Anchor const& other) {
+			return other.first == anchor.first && other.last == anchor.last && other.lastIndex == anchor.lastIndex;
+		});
+
+		if (!known) mAnchors.push_back(anchor);
+	}
+}
+
+void aurora::CacheSearch::start(std::vector<std::filesystem::path> files, PatternSet patterns) {
+	cancel();
+
+	mFiles = std::move(files);
+	mPatterns = std::move(patterns);
+	mPending.clear();
+	mCancel = false;
+	mRunning = true;
+	mFilesDone = 0;
+	mBytesDone = 0;
+	mElapsed = 0;
+	mBegin = std::chrono::steady_clock::now();
+
+	mThread = std::thread([this]() {
+		aurora::parallel_for(mFiles.size(), [&](size_t index, unsigned) {
+			if (mCancel) return;
+
+			auto file = MappedFile::open(mFiles[index]);
+			if (file) {
+				std::vector<Hit> hits;
+				mPatterns.scan(file->bytes(), [&](size_t offset, uint32_t pattern) {
+					hits.push_back({ static_cast<uint32_t>(index), pattern, offset });
+				});
+
+				// One lock per file, never per hit
+				if (!hits.empty()) {
+					std::lock_guard lock(mMutex);
+					mPending.insert(mPending.end(), hits.begin(), hits.end());
+				}
+
+				mBytesDone += file->size();
+			}
+
+			++mFilesDone;
+		});
+
+		mElapsed = (std::chrono::steady_clock::now() - mBegin).count();
+		mRunning = false;
+	});
+}
+
+void aurora::CacheSearch::cancel() {
+	mCancel = true;
+	if (mThread.joinable()) mThread.join();
+}
+
+void aurora::CacheSearch::collect(std::vector<Hit>& hits) {
+	std::lock_guard lock(mMutex);
+	hits.insert(hits.end(), mPending.begin(), mPending.end());
+	mPending.clear();
+}
+
+double aurora::CacheSearch::seconds() const {
+	auto elapsed = mRunning ? std::chrono::steady_clock::now() - mBegin : std::chrono::steady_clock::duration(mElapsed.load());
+	return std::chrono::duration<double>(elapsed).count();
+}
\ No newline at end of file
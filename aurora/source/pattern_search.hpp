@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define AURORA_SSE2 1
+#	include <emmintrin.h>
+#endif
+
+namespace aurora {
+	// Parses space separated hex bytes like "0C 00 00 00", returns std::nullopt on anything else
+	std::optional<std::vector<std::byte>> parse_hex_pattern(std::string_view text);
+
+	// Several byte patterns searched for in one pass
+	// Every position is first checked against the first and last byte of each pattern, 16 positions at a time with SSE2,
+	// only positions passing that prefilter are compared in full
+	class PatternSet final {
+	public:
+		PatternSet() = default;
+		explicit PatternSet(std::vector<std::vector<std::byte>> patterns);
+
+		std::span<std::vector<std::byte> const> patterns() const { return mPatterns; }
+
+		// Calls `on_hit(offset, patternIndex)` for every occurrence of every pattern, in offset order
+		template <class Fn>
+		void scan(std::span<std::byte const> data, Fn&& on_hit) const {
+			if (mPatterns.empty()) return;
+
+			uint8_t const* bytes = reinterpret_cast<uint8_t const*>(data.data());
+			size_t const size = data.size();
+			size_t offset = 0;
+
+			auto verify = [&](size_t position) {
+				for (size_t i = 0; i < mPatterns.size(); ++i) {
+					std::vector<std::byte> const& pattern = mPatterns[i];
+					if (size - position < pattern.size()) continue;
+					if (memcmp(bytes + position, pattern.data(), pattern.size()) == 0) on_hit(position, static_cast<uint32_t>(i));
+				}
+			};
+
+#ifdef AURORA_SSE2
+			// Every load of the block stays inside the data
+			while (size >= mLongest + 15 && offset <= size - mLongest - 15) {
+				__m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes + offset));
+				__m128i candidates = _mm_setzero_si128();
+
+				for (Anchor const& anchor : mAnchors) {
+					__m128i first = _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(anchor.first)));
+					__m128i tail = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes + offset + anchor.lastIndex));
+					__m128i last = _mm_cmpeq_epi8(tail, _mm_set1_epi8(static_cast<char>(anchor.last)));
+					candidates = _mm_or_si128(candidates, _mm_and_si128(first, last));
+				}
+
+				for (unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(candidates)); mask != 0; mask &= mask - 1)
+					verify(offset + std::countr_zero(mask));
+
+				offset += 16;
+			}
+#endif
+
+			for (; offset < size; ++offset)
+				verify(offset);
+		}
+	private:
+		struct Anchor {
+			uint8_t first;
+			uint8_t last;
+			size_t lastIndex;
+		};
+
+		std::vector<std::vector<std::byte>> mPatterns;
+		std::vector<Anchor> mAnchors; // One per distinct first, last byte pair
+		size_t mLongest = 0;
+	};
+
+	// Scans a list of files for a PatternSet on a background thread, hits can be collected while it runs
+	class CacheSearch final {
+	public:
+		struct Hit {
+			uint32_t file;
+			uint32_t pattern;
+			uint64_t offset;
+		};
+
+		CacheSearch() = default;
+		CacheSearch(CacheSearch const&) = delete;
+		CacheSearch& operator=(CacheSearch const&) = delete;
+		~CacheSearch() { cancel(); }
+
+		// Cancels any search still running first
+		void start(std::vector<std::filesystem::path> files, PatternSet patterns);
+		void cancel();
+
+		// Moves the hits found since the last call to the end of `hits`
+		void collect(std::vector<Hit>& hits);
+
+		bool running() const { return mRunning; }
+		size_t files_done() const { return mFilesDone; }
+		uint64_t bytes_done() const { return mBytesDone; }
+		double seconds() const;
+
+		std::span<std::filesystem::path const> files() const { return mFiles; }
+		PatternSet const& patterns() const { return mPatterns; }
+	private:
+		std::vector<std::filesystem::path> mFiles;
+		PatternSet mPatterns;
+
+		std::thread mThread;
+		std::atomic_bool mCancel = false;
+		std::atomic_bool mRunning = false;
+		std::atomic_size_t mFilesDone = 0;
+		std::atomic_uint64_t mBytesDone = 0;
+		std::chrono::steady_clock::time_point mBegin;
+		std::atomic<std::chrono::steady_clock::duration::rep> mElapsed = 0;
+
+		std::mutex mMutex;
+		std::vector<Hit> mPending;
+	};
+}
\ No newline at end of file
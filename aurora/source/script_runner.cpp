@@ -0,0 +1,171 @@
+#include "script_runner.hpp"
+
+#include <lua.hpp>
+
+#include <algorithm>
+#include <charconv>
+
+namespace {
+	// Instructions between two hook calls, small enough to stop close to the budget and large enough to cost nothing
+	constexpr int kHookInterval = 1000;
+
+	// Chunk name of every script, errors read "script:<line>: <message>"
+	constexpr char kChunkName[] = "=script";
+	constexpr std::string_view kErrorPrefix = "script:";
+
+	// Every state keeps its runner in the extra space, coroutines inherit it from the main thread
+	aurora::ScriptRunner*& runner_of(lua_State* L) {
+		return *static_cast<aurora::ScriptRunner**>(lua_getextraspace(L));
+	}
+
+	int parse_error_line(std::string_view message) {
+		if (!message.starts_with(kErrorPrefix)) return 0;
+		message.remove_prefix(kErrorPrefix.size());
+
+		int line = 0;
+		auto result = std::from_chars(message.data(), message.data() + message.size(), line);
+		if (result.ec != std::errc() || result.ptr == message.data() + message.size() || *result.ptr != ':') return 0;
+		return line;
+	}
+}
+
+bool aurora::ScriptRunner::start(std::string_view source, Mode mode, Setup setup) {
+	stop();
+
+	mLua = luaL_newstate();
+	luaL_openlibs(mLua);
+	if (setup) setup(mLua);
+	runner_of(mLua) = this;
+
+	mCoroutine = lua_newthread(mLua);
+
+	mError.clear();
+	mErrorLine = 0;
+	mLine = 0;
+	mInstructions = 0;
+	mStopRequested = false;
+
+	if (luaL_loadbuffer(mCoroutine, source.data(), source.size(), kChunkName) != LUA_OK) {
+		finish(LUA_ERRSYNTAX);
+		return false;
+	}
+
+	mMode = mode;
+	mState = State::kRunning;
+	mStarted = std::chrono::steady_clock::now();
+
+	if (mode == Mode::kWorker) {
+		mInterval = kHookInterval;
+		lua_sethook(mCoroutine, hook, LUA_MASKCOUNT, mInterval);
+
+		mWorkerDone = false;
+		mWorker = std::thread([this] {
+			int results = 0;
+			mWorkerStatus = lua_resume(mCoroutine, nullptr, 0, &results);
+			mEnded = std::chrono::steady_clock::now();
+			mWorkerDone.store(true, std::memory_order_release);
+		});
+	}
+
+	return true;
+}
+
+void aurora::ScriptRunner::update(Budget budget, double milliseconds, uint64_t instructions) {
+	if (mState != State::kRunning) return;
+
+	if (mMode == Mode::kWorker) {
+		if (!mWorkerDone.load(std::memory_order_acquire)) return;
+		mWorker.join();
+		finish(mWorkerStatus);
+		return;
+	}
+
+	instructions = std::max<uint64_t>(instructions, 1);
+
+	mBudget = budget;
+	mSliceLeft = static_cast<int64_t>(std::min<uint64_t>(instructions, INT64_MAX));
+	mSliceEnd = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(milliseconds));
+
+	// Instruction budgets below the hook interval are honoured exactly, setting the hook also restarts its count
+	mInterval = budget == Budget::kInstructions ? static_cast<int>(std::min<uint64_t>(instructions, kHookInterval)) : kHookInterval;
+	lua_sethook(mCoroutine, hook, LUA_MASKCOUNT, mInterval);
+
+	int results = 0;
+	int status = lua_resume(mCoroutine, nullptr, 0, &results);
+
+	if (status == LUA_YIELD) {
+		lua_pop(mCoroutine, results); // Values of a coroutine.yield at the top level of the script
+		return;
+	}
+
+	mEnded = std::chrono::steady_clock::now();
+	finish(status);
+}
+
+void aurora::ScriptRunner::stop() {
+	if (mState == State::kRunning) {
+		if (mMode == Mode::kWorker) {
+			mStopRequested = true;
+			mWorker.join();
+			finish(mWorkerStatus);
+		}
+		else {
+			mEnded = std::chrono::steady_clock::now();
+			mState = State::kStopped;
+		}
+	}
+
+	close();
+}
+
+double aurora::ScriptRunner::seconds() const {
+	if (mState == State::kIdle) return 0.0;
+	auto end = mState == State::kRunning ? std::chrono::steady_clock::now() : mEnded;
+	return std::chrono::duration<double>(end - mStarted).count();
+}
+
+void aurora::ScriptRunner::hook(lua_State* L, lua_Debug* ar) {
+	ScriptRunner& runner = *runner_of(L);
+
+	lua_getinfo(L, "l", ar);
+	if (ar->currentline > 0) runner.mLine.store(ar->currentline, std::memory_order_relaxed);
+	runner.mInstructions.fetch_add(runner.mInterval, std::memory_order_relaxed);
+
+	if (runner.mMode == Mode::kWorker) {
+		if (runner.mStopRequested.load(std::memory_order_relaxed)) luaL_error(L, "Stopped");
+		return;
+	}
+
+	bool spent = false;
+	if (runner.mBudget == Budget::kTime)
+		spent = std::chrono::steady_clock::now() >= runner.mSliceEnd;
+	else
+		spent = (runner.mSliceLeft -= runner.mInterval) <= 0;
+
+	// Hooks inside a call from C, like a sort comparator, can't yield. The next hook call tries again
+	if (spent && lua_isyieldable(L)) lua_yield(L, 0);
+}
+
+void aurora::ScriptRunner::finish(int status) {
+	if (status == LUA_OK) {
+		mState = State::kFinished;
+	}
+	else if (mStopRequested) {
+		mState = State::kStopped;
+	}
+	else {
+		char const* message = lua_tostring(mCoroutine, -1);
+		mError = message ? message : "Script raised an error that isn't a string";
+		mErrorLine = parse_error_line(mError);
+		mState = State::kFailed;
+	}
+
+	close();
+}
+
+void aurora::ScriptRunner::close() {
+	if (!mLua) return;
+	lua_close(mLua);
+	mLua = nullptr;
+	mCoroutine = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+
+struct lua_State;
+struct lua_Debug;
+
+namespace aurora {
+	// Runs one Lua script at a time on its own coroutine
+	// Sliced runs are resumed once per frame and yield from a count hook once the frame's budget is spent
+	// Worker runs go to completion on a separate thread, the hook only publishes progress and checks for `stop`
+	class ScriptRunner final {
+	public:
+		enum class Mode { kSliced, kWorker };
+		enum class Budget { kTime, kInstructions };
+		enum class State { kIdle, kRunning, kFinished, kFailed, kStopped };
+
+		// Registers the libraries a script can use on a fresh state
+		using Setup = void(*)(lua_State*);
+
+		ScriptRunner() = default;
+		ScriptRunner(ScriptRunner const&) = delete;
+		ScriptRunner& operator=(ScriptRunner const&) = delete;
+		~ScriptRunner() { stop(); }
+
+		// Stops any previous run, returns false if the source doesn't compile
+		bool start(std::string_view source, Mode mode, Setup setup);
+
+		// Call once per frame. Sliced runs execute until the budget is spent, finished worker runs are collected
+		void update(Budget budget, double milliseconds, uint64_t instructions);
+
+		void stop();
+
+		State state() const { return mState; }
+		Mode mode() const { return mMode; }
+		bool running() const { return mState == State::kRunning; }
+		bool running_on_worker() const { return mState == State::kRunning && mMode == Mode::kWorker; }
+
+		// Line the script was at when the hook last ran, 0 if unknown
+		int line() const { return mLine.load(std::memory_order_relaxed); }
+		// Counted in steps of the hook interval
+		uint64_t instructions() const { return mInstructions.load(std::memory_order_relaxed); }
+		double seconds() const;
+
+		std::string const& error() const { return mError; }
+		// Line the error was raised on, 0 if the message doesn't name one
+		int error_line() const { return mErrorLine; }
+	private:
+		static void hook(lua_State* L, lua_Debug* ar);
+		void finish(int status);
+		void close();
+
+		lua_State* mLua = nullptr;
+		lua_State* mCoroutine = nullptr;
+		State mState = State::kIdle;
+		Mode mMode = Mode::kSliced;
+
+		// Only touched by the thread running the coroutine
+		Budget mBudget = Budget::kTime;
+		int mInterval = 0;
+		int64_t mSliceLeft = 0;
+		std::chrono::steady_clock::time_point mSliceEnd;
+
+		std::atomic<int> mLine = 0;
+		std::atomic<uint64_t> mInstructions = 0;
+		std::chrono::steady_clock::time_point mStarted;
+		std::chrono::steady_clock::time_point mEnded;
+
+		std::thread mWorker;
+		std::atomic<bool> mWorkerDone = false;
+		std::atomic<bool> mStopRequested = false;
+		int mWorkerStatus = 0;
+
+		std::string mError;
+		int mErrorLine = 0;
+	};
+}
\ No newline at end of file
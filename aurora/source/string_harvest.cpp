@@ -0,0 +1,153 @@
+#include "string_harvest.hpp"
+
+#include "hashtable.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define AURORA_SSE2 1
+#endif
+
+namespace {
+	bool printable(uint8_t c) {
+		return c >= 0x20 && c < 0x7f;
+	}
+
+	// Bit i set when byte i of the 16 at `bytes` is printable
+	uint32_t printable_mask(uint8_t const* bytes) {
+#ifdef AURORA_SSE2
+		// Signed compares, bytes from 0x80 up are negative and fail the first one
+		__m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes));
+		__m128i above = _mm_cmpgt_epi8(block, _mm_set1_epi8(0x1f));
+		__m128i below = _mm_cmplt_epi8(block, _mm_set1_epi8(0x7f));
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(above, below)));
+#else
+		uint32_t mask = 0;
+		for (int i = 0; i < 16; ++i)
+			mask |= uint32_t(printable(bytes[i])) << i;
+		return mask;
+#endif
+	}
+}
+
+void aurora::find_prefixed_strings(std::span<std::byte const> data, std::vector<std::string_view>& strings, size_t minLength, size_t maxLength) {
+	uint8_t const* bytes = reinterpret_cast<uint8_t const*>(data.data());
+	size_t const size = data.size();
+
+	auto check = [&](size_t start) {
+		if (start < sizeof(uint32_t)) return;
+
+		uint32_t length;
+		memcpy(&length, bytes + start - sizeof(uint32_t), sizeof(uint32_t));
+		if (length < minLength || length > maxLength || length > size - start) return;
+
+		for (size_t i = 0; i < length; ++i)
+			if (!printable(bytes[start + i])) return;
+
+		strings.emplace_back(reinterpret_cast<char const*>(bytes + start), length);
+	};
+
+	size_t offset = 0;
+	uint32_t previous = 0; // Printable bit of the byte before `offset`
+
+	for (; size >= 16 && offset <= size - 16; offset += 16) {
+		uint32_t mask = printable_mask(bytes + offset);
+		uint32_t starts = mask & ~((mask << 1) | previous);
+		previous = (mask >> 15) & 1;
+
+		for (; starts != 0; starts &= starts - 1)
+			check(offset + std::countr_zero(starts));
+	}
+
+	for (; offset < size; ++offset) {
+		uint32_t current = printable(bytes[offset]);
+		if (current && !previous) check(offset);
+		previous = current;
+	}
+}
+
+void aurora::StringHarvest::start(std::vector<std::filesystem::path> files) {
+	cancel();
+
+	mFiles = std::move(files);
+	mCancel = false;
+	mRunning = true;
+	mFilesDone = 0;
+
+	{
+		std::lock_guard lock(mMutex);
+		mResult = std::nullopt;
+	}
+
+	mThread = std::thread([this]() {
+		auto begin = std::chrono::steady_clock::now();
+
+		// Each worker only ever touches its own strings, copied out before the file is unmapped
+		std::vector<std::vector<std::string>> found(aurora::worker_count());
+		std::atomic_uint64_t foundCount = 0;
+		std::atomic_uint64_t bytes = 0;
+
+		aurora::parallel_for(mFiles.size(), [&](size_t index, unsigned worker) {
+			if (mCancel) return;
+
+			if (auto file = MappedFile::open(mFiles[index])) {
+				std::vector<std::string_view> strings;
+				find_prefixed_strings(file->bytes(), strings);
+				foundCount += strings.size();
+				bytes += file->size();
+
+				std::sort(strings.begin(), strings.end());
+				strings.erase(std::unique(strings.begin(), strings.end()), strings.end());
+				found[worker].insert(found[worker].end(), strings.begin(), strings.end());
+			}
+
+			++mFilesDone;
+		});
+
+		Result result;
+		result.found = foundCount;
+		result.bytes = bytes;
+		result.cancelled = mCancel;
+
+		if (!result.cancelled) {
+			std::vector<std::string> merged;
+			for (auto& strings : found)
+				merged.insert(merged.end(), std::make_move_iterator(strings.begin()), std::make_move_iterator(strings.end()));
+
+			std::sort(merged.begin(), merged.end());
+			merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+
+			result.strings.reserve(merged.size());
+			for (std::string& text : merged) {
+				uint32_t hash = aurora::hash32(text);
+				result.strings.push_back({ hash, std::move(text) });
+			}
+		}
+
+		result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		{
+			std::lock_guard lock(mMutex);
+			mResult = std::move(result);
+		}
+
+		mRunning = false;
+	});
+}
+
+void aurora::StringHarvest::cancel() {
+	mCancel = true;
+	if (mThread.joinable()) mThread.join();
+}
+
+std::optional<aurora::StringHarvest::Result> aurora::StringHarvest::take() {
+	if (mRunning) return std::nullopt;
+
+	std::lock_guard lock(mMutex);
+	return std::exchange(mResult, std::nullopt);
+}
\ No newline at end of file
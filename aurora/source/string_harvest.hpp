@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace aurora {
+	// Every plausible length prefixed string in `data`: a u32 length followed by that many printable ASCII bytes
+	// The prefix always ends in a non printable byte, so a string can only start where a run of printable bytes starts.
+	// Those runs are found 16 bytes at a time with SSE2, only their starts are checked against the prefix in front of them
+	void find_prefixed_strings(std::span<std::byte const> data, std::vector<std::string_view>& strings, size_t minLength = 3, size_t maxLength = 255);
+
+	// Collects the distinct length prefixed strings of a list of files on a background thread and hashes them
+	class StringHarvest final {
+	public:
+		struct String {
+			uint32_t hash;
+			std::string text;
+		};
+
+		struct Result {
+			std::vector<String> strings; // Sorted by text, distinct
+			uint64_t found = 0; // Before removing duplicates
+			uint64_t bytes = 0;
+			double seconds = 0.0;
+			bool cancelled = false; // `found` and `bytes` only cover the files done by then, `strings` is empty
+		};
+
+		StringHarvest() = default;
+		StringHarvest(StringHarvest const&) = delete;
+		StringHarvest& operator=(StringHarvest const&) = delete;
+		~StringHarvest() { cancel(); }
+
+		// Cancels any harvest still running first
+		void start(std::vector<std::filesystem::path> files);
+		void cancel();
+
+		// Returns the result once, after the harvest finished
+		std::optional<Result> take();
+
+		bool running() const { return mRunning; }
+		size_t files_done() const { return mFilesDone; }
+		size_t files_total() const { return mFiles.size(); }
+	private:
+		std::vector<std::filesystem::path> mFiles;
+
+		std::thread mThread;
+		std::atomic_bool mCancel = false;
+		std::atomic_bool mRunning = false;
+		std::atomic_size_t mFilesDone = 0;
+
+		std::mutex mMutex;
+		std::optional<Result> mResult;
+	};
+}
\ No newline at end of file
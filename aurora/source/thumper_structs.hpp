@@ -1,13 +1,18 @@
 #pragma once
 
+#include "binary_writer.hpp"
+#include "gathered_write.hpp"
 #include "vector_stream.hpp"
 
 #include <glm/glm.hpp>
 
+#include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <optional>
 #include <span>
 #include <filesystem>
+#include <vector>
 
 namespace thumper {
     struct Vertex final {
@@ -21,66 +26,169 @@ namespace thumper {
         uint16_t elements[3];
     };
 
+    // One LOD, a range of the vertex and triangle arrays shared by every LOD of its MeshFile
+    // Triangle indices are relative to the first vertex of their LOD
     struct Mesh final {
-        std::vector<Vertex> vertices;
-        std::vector<Triangle> triangles;
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+        uint32_t firstTriangle;
+        uint32_t triangleCount;
         uint16_t _unknownField4;
     };
 
     struct MeshFile final {
         std::vector<Mesh> meshes;
+        std::vector<Vertex> vertices; // Every LOD back to back
+        std::vector<Triangle> triangles; // Every LOD back to back
+
+        std::span<Vertex const> vertices_of(Mesh const& mesh) const {
+            return std::span(vertices).subspan(mesh.firstVertex, mesh.vertexCount);
+        }
+
+        std::span<Triangle const> triangles_of(Mesh const& mesh) const {
+            return std::span(triangles).subspan(mesh.firstTriangle, mesh.triangleCount);
+        }
+
+        // Appends a LOD after the existing ones
+        void add_mesh(std::span<Vertex const> meshVertices, std::span<Triangle const> meshTriangles, uint16_t unknownField4) {
+            meshes.push_back({
+                .firstVertex = static_cast<uint32_t>(vertices.size()),
+                .vertexCount = static_cast<uint32_t>(meshVertices.size()),
+                .firstTriangle = static_cast<uint32_t>(triangles.size()),
+                .triangleCount = static_cast<uint32_t>(meshTriangles.size()),
+                ._unknownField4 = unknownField4
+            });
+
+            vertices.insert(vertices.end(), meshVertices.begin(), meshVertices.end());
+            triangles.insert(triangles.end(), meshTriangles.begin(), meshTriangles.end());
+        }
+
+        // The mesh count shares its position with other headers, a few values never occur as real LOD counts
+        static bool plausible_mesh_count(uint32_t meshCount) {
+            if (meshCount == 0) return false; // No meshes to read
+            if (meshCount == 167 || meshCount == 174) return false; // Special values as part of other headers, the game never uses this many LODs
+            return true;
+        }
 
         static std::optional<MeshFile> from_file(std::filesystem::path const& path) {
-            auto stream = aurora::VectorStream::from_file(path);
+            auto stream = aurora::VectorStream::map_file(path);
             if (!stream) return std::nullopt;
             return deserialize(*stream);
         }
 
-        void to_file(std::filesystem::path const& path) const {
-            serialize().to_file(path);
-        }
+        // The bulk arrays go to disk straight from memory, only the small fields between them are staged
+        bool to_file(std::filesystem::path const& path) const {
+            std::vector<std::byte> fields(serialized_size() - std::as_bytes(std::span(vertices)).size() - std::as_bytes(std::span(triangles)).size());
+            aurora::BinaryWriter writer(fields);
 
-        static std::optional<MeshFile> deserialize(aurora::VectorStream& stream) {
-            if (stream.read_u32() != 6) return std::nullopt; // Header check
-            uint32_t meshCount = stream.read_u32();
+            std::vector<std::span<std::byte const>> pieces;
+            pieces.reserve(meshes.size() * 4 + 1);
 
-            if (meshCount == 0) return std::nullopt; // No meshes to read
-            if (meshCount == 167 || meshCount == 174) return std::nullopt; // Special values as part of other headers, the game never uses this many LODs
+            size_t fieldsBegin = 0;
+            auto flush_fields = [&]() {
+                pieces.push_back(std::span<std::byte const>(fields).subspan(fieldsBegin, writer.offset() - fieldsBegin));
+                fieldsBegin = writer.offset();
+            };
 
-            MeshFile file;
-            file.meshes.resize(meshCount);
+            writer.write_u32(6); // Header
+            writer.write_u32(static_cast<uint32_t>(meshes.size()));
 
-            for (int i = 0; i < meshCount; ++i) {
-                uint32_t vertexCount = stream.read_u32();
-                auto verticesBytes = stream.read_bytes(vertexCount * sizeof(Vertex));
-                file.meshes[i].vertices.resize(vertexCount);
-                memcpy(file.meshes[i].vertices.data(), verticesBytes.data(), verticesBytes.size_bytes());
+            for (auto const& mesh : meshes) {
+                writer.write_u32(mesh.vertexCount);
+                flush_fields();
+                pieces.push_back(std::as_bytes(vertices_of(mesh)));
+                writer.write_u32(mesh.triangleCount);
+                flush_fields();
+                pieces.push_back(std::as_bytes(triangles_of(mesh)));
+                writer.write_u16(mesh._unknownField4);
+            }
 
-                uint32_t triangleCount = stream.read_u32();
-                auto trianglesBytes = stream.read_bytes(triangleCount * sizeof(Triangle));
-                file.meshes[i].triangles.resize(triangleCount);
-                memcpy(file.meshes[i].triangles.data(), trianglesBytes.data(), trianglesBytes.size_bytes());
+            flush_fields();
+            return aurora::write_gathered(path, pieces);
+        }
 
-                file.meshes[i]._unknownField4 = stream.read_u16();
+        // Decodes in two passes, the first only walks the LOD headers to total up the counts
+        // The second copies every LOD straight into its place, each array is allocated exactly once
+        static std::optional<MeshFile> deserialize(aurora::VectorStream& stream) {
+            try {
+                if (stream.read_u32() != 6) return std::nullopt; // Header check
+                uint32_t meshCount = stream.read_u32();
+
+                if (!plausible_mesh_count(meshCount)) return std::nullopt;
+
+                // Also validates the whole file before anything is allocated
+                size_t const lodsBegin = stream.tell();
+                size_t totalVertices = 0;
+                size_t totalTriangles = 0;
+
+                for (uint32_t i = 0; i < meshCount; ++i) {
+                    uint32_t vertexCount = stream.read_u32();
+                    stream.read_bytes(vertexCount * sizeof(Vertex));
+                    uint32_t triangleCount = stream.read_u32();
+                    stream.read_bytes(triangleCount * sizeof(Triangle));
+                    stream.read_u16();
+
+                    totalVertices += vertexCount;
+                    totalTriangles += triangleCount;
+                }
+
+                MeshFile file;
+                file.meshes.resize(meshCount);
+                file.vertices.resize(totalVertices);
+                file.triangles.resize(totalTriangles);
+
+                stream.seek(lodsBegin);
+                uint32_t firstVertex = 0;
+                uint32_t firstTriangle = 0;
+
+                for (Mesh& mesh : file.meshes) {
+                    mesh.firstVertex = firstVertex;
+                    mesh.vertexCount = stream.read_u32();
+                    auto verticesBytes = stream.read_bytes(mesh.vertexCount * sizeof(Vertex));
+                    memcpy(file.vertices.data() + firstVertex, verticesBytes.data(), verticesBytes.size_bytes());
+
+                    mesh.firstTriangle = firstTriangle;
+                    mesh.triangleCount = stream.read_u32();
+                    auto trianglesBytes = stream.read_bytes(mesh.triangleCount * sizeof(Triangle));
+                    memcpy(file.triangles.data() + firstTriangle, trianglesBytes.data(), trianglesBytes.size_bytes());
+
+                    mesh._unknownField4 = stream.read_u16();
+
+                    firstVertex += mesh.vertexCount;
+                    firstTriangle += mesh.triangleCount;
+                }
+
+                return file;
+            }
+            catch (aurora::TruncatedData const&) {
+                return std::nullopt; // Truncated file, or another file type that happened to pass the header check
             }
+        }
 
-            return file;
+        size_t serialized_size() const {
+            return 2 * sizeof(uint32_t)
+                + meshes.size() * (2 * sizeof(uint32_t) + sizeof(uint16_t))
+                + std::as_bytes(std::span(vertices)).size()
+                + std::as_bytes(std::span(triangles)).size();
         }
 
-        aurora::VectorStream serialize() const {
-            aurora::VectorStream stream;
-            stream.write_u32(6); // Header
-            stream.write_u32(meshes.size());
+        std::vector<std::byte> serialize() const {
+            std::vector<std::byte> data(serialized_size());
+            aurora::BinaryWriter writer(data);
+
+            writer.write_u32(6); // Header
+            writer.write_u32(static_cast<uint32_t>(meshes.size()));
 
             for (auto const& mesh : meshes) {
-                stream.write_u32(mesh.vertices.size());
-                stream.write_bytes(std::as_bytes(std::span(mesh.vertices)));
-                stream.write_u32(mesh.triangles.size());
-                stream.write_bytes(std::as_bytes(std::span(mesh.triangles)));
-                stream.write_u16(mesh._unknownField4);
+                writer.write_u32(mesh.vertexCount);
+                writer.write_bytes(std::as_bytes(vertices_of(mesh)));
+                writer.write_u32(mesh.triangleCount);
+                writer.write_bytes(std::as_bytes(triangles_of(mesh)));
+                writer.write_u16(mesh._unknownField4);
             }
 
-            return stream;
+            assert(writer.remaining() == 0);
+            return data;
         }
     };
 }
\ No newline at end of file
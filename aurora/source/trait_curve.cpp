@@ -0,0 +1,174 @@
+#include "trait_curve.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define AURORA_SSE2 1
+#endif
+
+namespace {
+	float ease(aurora::TraitEasing easing, float u) {
+		switch (easing) {
+		case aurora::TraitEasing::kIn: return u * u;
+		case aurora::TraitEasing::kOut: return u * (2.0f - u);
+		case aurora::TraitEasing::kInOut: return u * u * (3.0f - 2.0f * u);
+		default: return u;
+		}
+	}
+
+	// Values of `count` times all inside the segment starting at `t0`, one easing for the whole run
+	void lerp_run(float t0, float scale, float v0, float delta, aurora::TraitEasing easing, float const* times, float* out, size_t count) {
+		size_t i = 0;
+
+#ifdef AURORA_SSE2
+		__m128 const start = _mm_set1_ps(t0);
+		__m128 const factor = _mm_set1_ps(scale);
+		__m128 const base = _mm_set1_ps(v0);
+		__m128 const range = _mm_set1_ps(delta);
+		__m128 const one = _mm_set1_ps(1.0f);
+		__m128 const two = _mm_set1_ps(2.0f);
+		__m128 const three = _mm_set1_ps(3.0f);
+
+		for (; i + 4 <= count; i += 4) {
+			__m128 u = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(times + i), start), factor);
+			u = _mm_min_ps(_mm_max_ps(u, _mm_setzero_ps()), one);
+
+			switch (easing) {
+			case aurora::TraitEasing::kIn: u = _mm_mul_ps(u, u); break;
+			case aurora::TraitEasing::kOut: u = _mm_mul_ps(u, _mm_sub_ps(two, u)); break;
+			case aurora::TraitEasing::kInOut: u = _mm_mul_ps(_mm_mul_ps(u, u), _mm_sub_ps(three, _mm_mul_ps(two, u))); break;
+			default: break;
+			}
+
+			_mm_storeu_ps(out + i, _mm_add_ps(base, _mm_mul_ps(range, u)));
+		}
+#endif
+
+		for (; i < count; ++i) {
+			float u = std::clamp((times[i] - t0) * scale, 0.0f, 1.0f);
+			out[i] = v0 + delta * ease(easing, u);
+		}
+	}
+}
+
+aurora::TraitInterpolation aurora::classify_interpolation(std::string_view name) {
+	return name.contains("Step") ? TraitInterpolation::kStep : TraitInterpolation::kLinear;
+}
+
+aurora::TraitEasing aurora::classify_easing(std::string_view name) {
+	if (name.contains("InOut")) return TraitEasing::kInOut;
+	if (name.contains("In")) return TraitEasing::kIn;
+	if (name.contains("Out")) return TraitEasing::kOut;
+	return TraitEasing::kNone;
+}
+
+aurora::LeafCurves::LeafCurves(Leaf const& leaf) {
+	std::vector<TraitInterpolation> interpolationOf;
+	std::vector<TraitEasing> easingOf;
+	for (std::string const& symbol : leaf.symbols) {
+		interpolationOf.push_back(classify_interpolation(symbol));
+		easingOf.push_back(classify_easing(symbol));
+	}
+
+	mCurves.reserve(leaf.traits.size());
+
+	for (Leaf::Trait const& trait : leaf.traits) {
+		TraitCodec const& codec = trait_codec(trait.traitType);
+		bool const scalar = codec.components == 1;
+		size_t const count = scalar ? trait.datapoint_count() : 0;
+
+		mCurves.push_back({ static_cast<uint32_t>(mTimes.size()), static_cast<uint32_t>(count) });
+
+		for (size_t i = 0; i < count; ++i) {
+			float value = 0.0f;
+			switch (codec.column) {
+			case TraitColumn::kFloats: value = trait.floats[i]; break;
+			case TraitColumn::kInts: value = static_cast<float>(trait.ints[i]); break;
+			case TraitColumn::kBytes: value = static_cast<float>(trait.bytes[i]); break;
+			default: break;
+			}
+
+			bool const stepped = codec.column != TraitColumn::kFloats;
+
+			mTimes.push_back(trait.times[i]);
+			mValues.push_back(value);
+			mInterpolations.push_back(stepped ? TraitInterpolation::kStep : interpolationOf[trait.interpolations[i]]);
+			mEasings.push_back(easingOf[trait.easings[i]]);
+		}
+	}
+}
+
+float aurora::LeafCurves::begin_time(size_t trait) const {
+	Curve const& curve = mCurves[trait];
+	return curve.count ? mTimes[curve.first] : 0.0f;
+}
+
+float aurora::LeafCurves::end_time(size_t trait) const {
+	Curve const& curve = mCurves[trait];
+	return curve.count ? mTimes[curve.first + curve.count - 1] : 0.0f;
+}
+
+float aurora::LeafCurves::sample(size_t trait, float time) const {
+	Curve const& curve = mCurves[trait];
+	if (curve.count == 0) return 0.0f;
+
+	float const* times = mTimes.data() + curve.first;
+	float const* values = mValues.data() + curve.first;
+
+	// Last datapoint at or before `time`
+	size_t next = std::upper_bound(times, times + curve.count, time) - times;
+	if (next == 0) return values[0];
+	if (next == curve.count) return values[curve.count - 1];
+
+	size_t i = next - 1;
+	size_t point = curve.first + i;
+	if (mInterpolations[point] == TraitInterpolation::kStep || times[next] <= times[i]) return values[i];
+
+	float u = (time - times[i]) / (times[next] - times[i]);
+	return values[i] + (values[next] - values[i]) * ease(mEasings[point], u);
+}
+
+void aurora::LeafCurves::sample_all(float time, std::span<float> out) const {
+	for (size_t trait = 0; trait < mCurves.size(); ++trait)
+		out[trait] = sample(trait, time);
+}
+
+void aurora::LeafCurves::sample(size_t trait, std::span<float const> times, std::span<float> out) const {
+	Curve const& curve = mCurves[trait];
+	if (curve.count == 0) {
+		std::fill(out.begin(), out.end(), 0.0f);
+		return;
+	}
+
+	float const* points = mTimes.data() + curve.first;
+	float const* values = mValues.data() + curve.first;
+	size_t const count = times.size();
+
+	// Before the first datapoint
+	size_t i = 0;
+	for (; i < count && times[i] < points[0]; ++i)
+		out[i] = values[0];
+
+	// Walk the segments and the times together, both are ascending
+	for (size_t segment = 0; segment + 1 < curve.count && i < count; ++segment) {
+		float const t0 = points[segment];
+		float const t1 = points[segment + 1];
+
+		size_t end = i;
+		while (end < count && times[end] < t1) ++end;
+		if (end == i) continue;
+
+		size_t point = curve.first + segment;
+		if (mInterpolations[point] == TraitInterpolation::kStep || t1 <= t0)
+			std::fill(out.begin() + i, out.begin() + end, values[segment]);
+		else
+			lerp_run(t0, 1.0f / (t1 - t0), values[segment], values[segment + 1] - values[segment], mEasings[point], times.data() + i, out.data() + i, end - i);
+
+		i = end;
+	}
+
+	// At or past the last datapoint
+	for (; i < count; ++i)
+		out[i] = values[curve.count - 1];
+}
\ No newline at end of file
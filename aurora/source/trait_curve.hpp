@@ -0,0 +1,63 @@
+#pragma once
+
+#include "leaf.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace aurora {
+	// How a datapoint moves on to the next one, classified from the names stored with each datapoint
+	enum struct TraitInterpolation : uint8_t {
+		kLinear,
+		kStep,
+	};
+
+	enum struct TraitEasing : uint8_t {
+		kNone,
+		kIn,
+		kOut,
+		kInOut,
+	};
+
+	// Names containing "Step" hold their value, anything else is linear
+	TraitInterpolation classify_interpolation(std::string_view name);
+	// "InOut", "In" and "Out" anywhere in the name, anything else isn't eased
+	TraitEasing classify_easing(std::string_view name);
+
+	// Every single valued trait of a leaf as a curve of floats, Float traits interpolate, Int, Enum, Bool and Action traits step
+	// Traits with several components per datapoint, e.g. Color or Vec3, get an empty curve
+	// Before the first datapoint a curve holds the first value, from the last one on the last value
+	class LeafCurves final {
+	public:
+		explicit LeafCurves(Leaf const& leaf);
+		LeafCurves() = default;
+
+		size_t size() const { return mCurves.size(); }
+		size_t point_count(size_t trait) const { return mCurves[trait].count; }
+		float begin_time(size_t trait) const;
+		float end_time(size_t trait) const;
+
+		// Single time, a binary search per trait
+		float sample(size_t trait, float time) const;
+		// Value of every trait at `time`, `out` holds one value per trait
+		void sample_all(float time, std::span<float> out) const;
+		// Many times of one trait, `times` must be ascending. Runs of times inside one segment are evaluated with SIMD
+		// so audio rate resolution over a whole level stays cheap
+		void sample(size_t trait, std::span<float const> times, std::span<float> out) const;
+	private:
+		struct Curve {
+			uint32_t first; // Into the columns below
+			uint32_t count;
+		};
+
+		std::vector<Curve> mCurves;
+
+		// Datapoints of every trait back to back
+		std::vector<float> mTimes;
+		std::vector<float> mValues;
+		std::vector<TraitInterpolation> mInterpolations;
+		std::vector<TraitEasing> mEasings;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "trigram_index.hpp"
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+	uint32_t trigram_at(std::string_view text, size_t i) {
+		return uint32_t(uint8_t(text[i])) << 16 | uint32_t(uint8_t(text[i + 1])) << 8 | uint8_t(text[i + 2]);
+	}
+
+	// Distinct trigrams of every string, sorted
+	void collect_trigrams(std::span<std::string_view const> strings, std::vector<uint32_t>& out) {
+		out.clear();
+		for (std::string_view string : strings)
+			for (size_t i = 0; i + 3 <= string.size(); ++i)
+				out.push_back(trigram_at(string, i));
+
+		std::sort(out.begin(), out.end());
+		out.erase(std::unique(out.begin(), out.end()), out.end());
+	}
+
+	std::vector<std::string_view> tokenize(std::string_view text) {
+		std::vector<std::string_view> tokens;
+
+		while (!text.empty()) {
+			size_t end = text.find(' ');
+			if (end != 0) tokens.push_back(text.substr(0, end));
+			if (end == std::string_view::npos) break;
+			text.remove_prefix(end + 1);
+		}
+
+		return tokens;
+	}
+}
+
+uint32_t aurora::TrigramIndex::add(std::span<std::string_view const> fields) {
+	mFields.insert(mFields.end(), fields.begin(), fields.end());
+	mDocuments.push_back(static_cast<uint32_t>(mFields.size()));
+	return static_cast<uint32_t>(mDocuments.size() - 2);
+}
+
+void aurora::TrigramIndex::build() {
+	size_t const count = size();
+
+	// Distinct trigrams per document in parallel, then a counting pass lays the postings out per trigram
+	std::vector<std::vector<uint32_t>> perDocument(count);
+	parallel_for(count, [&](size_t document, unsigned) {
+		std::span<std::string_view const> fields(mFields.data() + mDocuments[document], mDocuments[document + 1] - mDocuments[document]);
+		collect_trigrams(fields, perDocument[document]);
+	});
+
+	std::vector<uint32_t> all;
+	for (auto const& trigrams : perDocument)
+		all.insert(all.end(), trigrams.begin(), trigrams.end());
+	std::sort(all.begin(), all.end());
+
+	mTrigrams.clear();
+	mStarts.clear();
+	for (size_t i = 0; i < all.size(); ++i) {
+		if (i == 0 || all[i] != all[i - 1]) {
+			mTrigrams.push_back(all[i]);
+			mStarts.push_back(static_cast<uint32_t>(i));
+		}
+	}
+	mStarts.push_back(static_cast<uint32_t>(all.size()));
+
+	// Documents are visited in ascending order, so every posting list comes out sorted
+	std::vector<uint32_t> cursor(mStarts.begin(), mStarts.end() - 1);
+	mPostings.assign(all.size(), 0);
+	for (uint32_t document = 0; document < count; ++document) {
+		for (uint32_t trigram : perDocument[document]) {
+			size_t index = std::lower_bound(mTrigrams.begin(), mTrigrams.end(), trigram) - mTrigrams.begin();
+			mPostings[cursor[index]++] = document;
+		}
+	}
+}
+
+std::span<uint32_t const> aurora::TrigramIndex::postings(uint32_t trigram) const {
+	auto it = std::lower_bound(mTrigrams.begin(), mTrigrams.end(), trigram);
+	if (it == mTrigrams.end() || *it != trigram) return {};
+
+	size_t index = it - mTrigrams.begin();
+	return { mPostings.data() + mStarts[index], mStarts[index + 1] - mStarts[index] };
+}
+
+bool aurora::TrigramIndex::matches(uint32_t document, std::span<std::string_view const> tokens) const {
+	std::span<std::string_view const> fields(mFields.data() + mDocuments[document], mDocuments[document + 1] - mDocuments[document]);
+
+	for (std::string_view token : tokens) {
+		bool found = false;
+		for (std::string_view field : fields) {
+			if (field.find(token) != std::string_view::npos) {
+				found = true;
+				break;
+			}
+		}
+
+		if (!found) return false;
+	}
+
+	return true;
+}
+
+void aurora::TrigramIndex::query(std::span<std::string_view const> tokens, std::vector<uint32_t>& out) const {
+	out.clear();
+
+	std::vector<std::span<uint32_t const>> lists;
+	std::vector<uint32_t> trigrams;
+	for (std::string_view token : tokens) {
+		if (token.size() < 3) continue;
+
+		collect_trigrams({ &token, 1 }, trigrams);
+		for (uint32_t trigram : trigrams) {
+			std::span<uint32_t const> list = postings(trigram);
+			if (list.empty()) return; // No document has it
+			lists.push_back(list);
+		}
+	}
+
+	if (lists.empty()) {
+		out.resize(size());
+		std::iota(out.begin(), out.end(), 0u);
+	}
+	else {
+		// Shortest list first, every intersection after that only shrinks the candidates
+		std::sort(lists.begin(), lists.end(), [](auto const& a, auto const& b) { return a.size() < b.size(); });
+		out.assign(lists[0].begin(), lists[0].end());
+
+		// Intersected in place, a kept candidate is written at or before where it was read so nothing is overwritten early
+		for (size_t i = 1; i < lists.size() && !out.empty(); ++i) {
+			std::span<uint32_t const> list = lists[i];
+			size_t kept = 0;
+			size_t j = 0;
+
+			for (size_t k = 0; k < out.size() && j < list.size(); ++k) {
+				while (j < list.size() && list[j] < out[k]) ++j;
+				if (j < list.size() && list[j] == out[k]) out[kept++] = out[k];
+			}
+
+			out.resize(kept);
+		}
+	}
+
+	// Trigrams of a token may be spread over several fields, or short tokens weren't checked at all
+	std::erase_if(out, [&](uint32_t document) { return !matches(document, tokens); });
+}
+
+bool aurora::TrigramFilter::update(TrigramIndex const& index, std::string_view text) {
+	if (mValid && text == mText) return false;
+
+	std::vector<std::string_view> tokens = tokenize(text);
+
+	if (mValid && text.starts_with(mText))
+		std::erase_if(mResults, [&](uint32_t document) { return !index.matches(document, tokens); });
+	else
+		index.query(tokens, mResults);
+
+	mText = text;
+	mValid = true;
+	return true;
+}
\ No newline at end of file
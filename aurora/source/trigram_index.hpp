@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aurora {
+	// Substring search over documents made of a few strings each, e.g. an objlib with its name, imports and object names
+	// Every distinct three byte sequence maps to the sorted list of documents containing it. A query intersects the lists
+	// of its tokens and only verifies the few survivors, instead of searching every string of every document
+	class TrigramIndex final {
+	public:
+		// Views must outlive the index, returns the document id, ids count up from 0
+		uint32_t add(std::span<std::string_view const> fields);
+		void build();
+
+		// Documents where every token occurs in at least one field, ascending
+		// Tokens shorter than three bytes can't use the index, they are verified against the candidates of the others
+		void query(std::span<std::string_view const> tokens, std::vector<uint32_t>& out) const;
+		bool matches(uint32_t document, std::span<std::string_view const> tokens) const;
+
+		size_t size() const { return mDocuments.size() - 1; }
+		size_t trigram_count() const { return mTrigrams.size(); }
+	private:
+		std::span<uint32_t const> postings(uint32_t trigram) const;
+
+		std::vector<std::string_view> mFields;
+		std::vector<uint32_t> mDocuments{ 0 }; // Into mFields, one past the last document too
+
+		std::vector<uint32_t> mTrigrams; // Sorted
+		std::vector<uint32_t> mStarts; // Into mPostings, one past the last trigram too
+		std::vector<uint32_t> mPostings;
+	};
+
+	// Results of a filter text against an index, kept between frames
+	// Typing more characters can only narrow the results, so an extended text is checked against the previous results only
+	class TrigramFilter final {
+	public:
+		// Space separated tokens, an empty text matches every document
+		// Returns true if the results changed
+		bool update(TrigramIndex const& index, std::string_view text);
+		// The index was rebuilt
+		void invalidate() { mValid = false; }
+
+		std::span<uint32_t const> results() const { return mResults; }
+	private:
+		std::string mText;
+		std::vector<uint32_t> mResults;
+		bool mValid = false;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include "usage_index.hpp"
+
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <tuple>
+#include <utility>
+
+// Open addressing set of key indices, only probed for values that passed the bit filter
+class aurora::UsageIndex::KeyTable final {
+public:
+	explicit KeyTable(std::span<uint32_t const> keys) : mKeys(keys) {
+		mFilter.assign((1 << 20) / 64, 0);
+		for (uint32_t key : keys)
+			mFilter[(key >> 12) / 64] |= uint64_t(1) << ((key >> 12) % 64);
+
+		size_t capacity = std::bit_ceil(std::max<size_t>(16, keys.size() * 2));
+		mShift = 32 - std::countr_zero(capacity);
+		mSlots.assign(capacity, 0);
+
+		for (uint32_t i = 0; i < keys.size(); ++i) {
+			size_t slot = home(keys[i]);
+			while (mSlots[slot] != 0) slot = (slot + 1) & (capacity - 1);
+			mSlots[slot] = i + 1;
+		}
+	}
+
+	// Returns UINT32_MAX if `value` isn't a key
+	uint32_t find(uint32_t value) const {
+		if (!(mFilter[(value >> 12) / 64] & (uint64_t(1) << ((value >> 12) % 64)))) return UINT32_MAX;
+
+		for (size_t slot = home(value);; slot = (slot + 1) & (mSlots.size() - 1)) {
+			uint32_t index = mSlots[slot];
+			if (index == 0) return UINT32_MAX;
+			if (mKeys[index - 1] == value) return index - 1;
+		}
+	}
+private:
+	size_t home(uint32_t value) const {
+		return (value * 0x9e3779b1u) >> mShift;
+	}
+
+	std::span<uint32_t const> mKeys;
+	std::vector<uint64_t> mFilter;
+	std::vector<uint32_t> mSlots; // Key index + 1, 0 is empty
+	int mShift = 0;
+};
+
+namespace {
+	void write_varint(std::vector<uint8_t>& out, uint32_t value) {
+		while (value >= 0x80) {
+			out.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<uint8_t>(value));
+	}
+
+	uint32_t read_varint(uint8_t const*& in) {
+		uint32_t value = 0;
+		for (int shift = 0;; shift += 7) {
+			uint8_t byte = *in++;
+			value |= uint32_t(byte & 0x7f) << shift;
+			if (!(byte & 0x80)) return value;
+		}
+	}
+}
+
+std::vector<uint32_t> aurora::UsageIndex::distinct(std::vector<uint32_t> keys) {
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+	return keys;
+}
+
+void aurora::UsageIndex::scan(std::span<std::byte const> data, KeyTable const& table, uint32_t file, std::vector<Occurrence>& found) {
+	if (data.size() < sizeof(uint32_t)) return;
+
+	for (size_t offset = 0; offset <= data.size() - sizeof(uint32_t); ++offset) {
+		uint32_t value;
+		memcpy(&value, data.data() + offset, sizeof(value));
+
+		uint32_t key = table.find(value);
+		if (key != UINT32_MAX) found.push_back({ key, file, static_cast<uint32_t>(offset) });
+	}
+}
+
+aurora::UsageIndex aurora::UsageIndex::assemble(std::vector<uint32_t> keys, std::vector<std::vector<Occurrence>>& found) {
+	UsageIndex index;
+	index.mKeys = std::move(keys);
+
+	std::vector<Occurrence> occurrences;
+	for (auto& workerFound : found)
+		occurrences.insert(occurrences.end(), workerFound.begin(), workerFound.end());
+
+	std::sort(occurrences.begin(), occurrences.end(), [](Occurrence const& a, Occurrence const& b) {
+		return std::tie(a.key, a.file, a.offset) < std::tie(b.key, b.file, b.offset);
+	});
+
+	index.mUsageCount = occurrences.size();
+	index.mCounts.assign(index.mKeys.size(), 0);
+	index.mStarts.assign(index.mKeys.size() + 1, 0);
+
+	// The first usage of a key is stored against file 0 offset 0, every other against the one before
+	size_t next = 0;
+	for (uint32_t key = 0; key < index.mKeys.size(); ++key) {
+		index.mStarts[key] = static_cast<uint32_t>(index.mPostings.size());
+
+		uint32_t file = 0, offset = 0;
+		for (; next < occurrences.size() && occurrences[next].key == key; ++next) {
+			Occurrence const& occurrence = occurrences[next];
+			if (occurrence.file != file) offset = 0;
+
+			write_varint(index.mPostings, occurrence.file - file);
+			write_varint(index.mPostings, occurrence.offset - offset);
+			file = occurrence.file;
+			offset = occurrence.offset;
+			++index.mCounts[key];
+		}
+	}
+
+	index.mStarts.back() = static_cast<uint32_t>(index.mPostings.size());
+	index.mPostings.shrink_to_fit();
+	return index;
+}
+
+aurora::UsageIndex aurora::UsageIndex::build(std::span<std::span<std::byte const> const> files, std::vector<uint32_t> keys) {
+	keys = distinct(std::move(keys));
+	KeyTable const table(keys);
+
+	// Each worker only ever touches its own occurrences
+	std::vector<std::vector<Occurrence>> found(aurora::worker_count());
+
+	aurora::parallel_for(files.size(), [&](size_t file, unsigned worker) {
+		scan(files[file], table, static_cast<uint32_t>(file), found[worker]);
+	});
+
+	return assemble(std::move(keys), found);
+}
+
+size_t aurora::UsageIndex::key_index(uint32_t key) const {
+	auto it = std::lower_bound(mKeys.begin(), mKeys.end(), key);
+	if (it == mKeys.end() || *it != key) return SIZE_MAX;
+	return static_cast<size_t>(it - mKeys.begin());
+}
+
+size_t aurora::UsageIndex::count(uint32_t key) const {
+	size_t index = key_index(key);
+	return index == SIZE_MAX ? 0 : mCounts[index];
+}
+
+std::vector<aurora::UsageIndex::Usage> aurora::UsageIndex::find(uint32_t key) const {
+	std::vector<Usage> usages;
+
+	size_t index = key_index(key);
+	if (index == SIZE_MAX) return usages;
+
+	usages.reserve(mCounts[index]);
+	uint8_t const* in = mPostings.data() + mStarts[index];
+
+	uint32_t file = 0, offset = 0;
+	for (uint32_t i = 0; i < mCounts[index]; ++i) {
+		uint32_t fileDelta = read_varint(in);
+		if (fileDelta != 0) offset = 0;
+
+		file += fileDelta;
+		offset += read_varint(in);
+		usages.push_back({ file, offset });
+	}
+
+	return usages;
+}
+
+void aurora::UsageIndexBuilder::start(std::vector<std::filesystem::path> files, std::vector<uint32_t> keys) {
+	cancel();
+
+	mFiles = std::move(files);
+	mKeys = std::move(keys);
+	mCancel = false;
+	mRunning = true;
+	mFilesDone = 0;
+
+	{
+		std::lock_guard lock(mMutex);
+		mResult = std::nullopt;
+	}
+
+	mThread = std::thread([this]() {
+		std::vector<uint32_t> keys = UsageIndex::distinct(std::move(mKeys));
+		UsageIndex::KeyTable const table(keys);
+
+		std::vector<std::vector<UsageIndex::Occurrence>> found(aurora::worker_count());
+
+		aurora::parallel_for(mFiles.size(), [&](size_t index, unsigned worker) {
+			if (mCancel) return;
+
+			if (auto file = MappedFile::open(mFiles[index]))
+				UsageIndex::scan(file->bytes(), table, static_cast<uint32_t>(index), found[worker]);
+
+			++mFilesDone;
+		});
+
+		if (!mCancel) {
+			UsageIndex index = UsageIndex::assemble(std::move(keys), found);
+
+			std::lock_guard lock(mMutex);
+			mResult = std::move(index);
+		}
+
+		mRunning = false;
+	});
+}
+
+void aurora::UsageIndexBuilder::cancel() {
+	mCancel = true;
+	if (mThread.joinable()) mThread.join();
+}
+
+std::optional<aurora::UsageIndex> aurora::UsageIndexBuilder::take() {
+	if (mRunning) return std::nullopt;
+
+	std::lock_guard lock(mMutex);
+	return std::exchange(mResult, std::nullopt);
+}
\ No newline at end of file
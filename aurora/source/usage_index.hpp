@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace aurora {
+	// Every place a set of u32 keys occurs in a list of buffers, at any byte offset
+	// Postings of a key are sorted by file then offset and stored as LEB128 deltas, a few bytes per usage.
+	// Any u32 that happens to equal a key counts, for 32 bit hashes that is rare enough to be useful
+	class UsageIndex final {
+	public:
+		struct Usage {
+			uint32_t file; // Index into the buffers given to `build`
+			uint32_t offset;
+		};
+
+		// Buffers are scanned in parallel, keys may repeat
+		static UsageIndex build(std::span<std::span<std::byte const> const> files, std::vector<uint32_t> keys);
+
+		std::vector<Usage> find(uint32_t key) const;
+		size_t count(uint32_t key) const;
+
+		size_t key_count() const { return mKeys.size(); }
+		size_t usage_count() const { return mUsageCount; }
+		size_t posting_bytes() const { return mPostings.size(); }
+	private:
+		class KeyTable;
+
+		struct Occurrence {
+			uint32_t key; // Index into the distinct sorted keys
+			uint32_t file;
+			uint32_t offset;
+		};
+
+		// Steps of a build, shared with UsageIndexBuilder
+		static std::vector<uint32_t> distinct(std::vector<uint32_t> keys);
+		static void scan(std::span<std::byte const> data, KeyTable const& table, uint32_t file, std::vector<Occurrence>& found);
+		static UsageIndex assemble(std::vector<uint32_t> keys, std::vector<std::vector<Occurrence>>& found);
+
+		// Returns SIZE_MAX for keys that aren't indexed
+		size_t key_index(uint32_t key) const;
+
+		std::vector<uint32_t> mKeys; // Sorted
+		std::vector<uint32_t> mCounts;
+		std::vector<uint32_t> mStarts; // Into mPostings, one past the last key too
+		std::vector<uint8_t> mPostings;
+		size_t mUsageCount = 0;
+
+		friend class UsageIndexBuilder;
+	};
+
+	// Builds a UsageIndex of a list of files on a background thread, each file is mapped only while it's scanned
+	class UsageIndexBuilder final {
+	public:
+		UsageIndexBuilder() = default;
+		UsageIndexBuilder(UsageIndexBuilder const&) = delete;
+		UsageIndexBuilder& operator=(UsageIndexBuilder const&) = delete;
+		~UsageIndexBuilder() { cancel(); }
+
+		// Cancels any build still running first, file indices of the index are positions in `files`
+		void start(std::vector<std::filesystem::path> files, std::vector<uint32_t> keys);
+		void cancel();
+
+		// Returns the index once, after a build finished without being cancelled. Files that can't be opened have no usages
+		std::optional<UsageIndex> take();
+
+		bool running() const { return mRunning; }
+		size_t files_done() const { return mFilesDone; }
+		std::span<std::filesystem::path const> files() const { return mFiles; }
+	private:
+		std::vector<std::filesystem::path> mFiles;
+		std::vector<uint32_t> mKeys;
+
+		std::thread mThread;
+		std::atomic_bool mCancel = false;
+		std::atomic_bool mRunning = false;
+		std::atomic_size_t mFilesDone = 0;
+
+		std::mutex mMutex;
+		std::optional<UsageIndex> mResult;
+	};
+}
\ No newline at end of file
@@ -8,6 +8,9 @@
 #include <fstream>
 #include <optional>
 
+#include "binary_cursor.hpp"
+#include "mapped_file.hpp"
+
 namespace aurora {
 	class VectorStream final {
 	public:
@@ -20,47 +23,79 @@ namespace aurora {
 			stream.mData.resize(file.tellg());
 			file.seekg(0, std::ios::beg);
 			file.read(reinterpret_cast<char*>(stream.mData.data()), stream.mData.size());
+			stream.mView = stream.mData;
+			return stream;
+		}
+
+		// Read only stream served directly from a file mapping, no heap copy is made
+		static std::optional<VectorStream> map_file(std::filesystem::path const& path) {
+			auto mapping = MappedFile::open(path);
+			if (!mapping) return std::nullopt;
+
+			VectorStream stream;
+			stream.mMapping = std::move(mapping);
+			stream.mView = stream.mMapping->bytes();
 			return stream;
 		}
 
 		void to_file(std::filesystem::path const& path) const {
 			std::ofstream stream(path, std::ios::out | std::ios::binary);
-			stream.write(reinterpret_cast<char const*>(mData.data()), mData.size());
+			stream.write(reinterpret_cast<char const*>(mView.data()), mView.size());
 		}
 
-		std::span<std::byte> read_bytes(size_t count) {
-			std::span<std::byte> v = std::span(mData.data() + mMark, count);
-			mMark += count;
+		// Reads are bounds checked and throw aurora::TruncatedData past the end
+		std::span<std::byte const> read_bytes(size_t count) {
+			BinaryCursor cursor(mView, mMark);
+			std::span<std::byte const> v = cursor.read_bytes(count);
+			mMark = cursor.offset();
 			return v;
 		}
 
 		uint16_t read_u16() {
-			uint16_t v = *reinterpret_cast<uint16_t*>(mData.data() + mMark);
-			mMark += sizeof(v);
+			BinaryCursor cursor(mView, mMark);
+			uint16_t v = cursor.read_u16();
+			mMark = cursor.offset();
 			return v;
 		}
 
 		uint32_t read_u32() {
-			uint32_t v = *reinterpret_cast<uint32_t*>(mData.data() + mMark);
-			mMark += sizeof(v);
+			BinaryCursor cursor(mView, mMark);
+			uint32_t v = cursor.read_u32();
+			mMark = cursor.offset();
 			return v;
 		}
 
+		size_t tell() const { return mMark; }
+
+		void seek(size_t offset) {
+			if (offset > mView.size()) throw TruncatedData("Seek past end of data");
+			mMark = offset;
+		}
+
 		void write_bytes(std::span<std::byte const> v) {
+			detach();
 			mData.append_range(v);
+			mView = mData;
 		}
 
 		void write_u16(uint16_t v) {
-			std::span<std::byte> view = std::span(reinterpret_cast<std::byte*>(&v), sizeof(v));
-			mData.append_range(view);
+			write_bytes(std::as_bytes(std::span(&v, 1)));
 		}
 
 		void write_u32(uint32_t v) {
-			std::span<std::byte> view = std::span(reinterpret_cast<std::byte*>(&v), sizeof(v));
-			mData.append_range(view);
+			write_bytes(std::as_bytes(std::span(&v, 1)));
 		}
 	private:
+		// Writing into a mapped stream first moves its contents into the owned vector
+		void detach() {
+			if (!mMapping) return;
+			mData.assign(mView.begin(), mView.end());
+			mMapping.reset();
+		}
+
 		size_t mMark = 0;
 		std::vector<std::byte> mData;
+		std::optional<MappedFile> mMapping;
+		std::span<std::byte const> mView;
 	};
 }
\ No newline at end of file